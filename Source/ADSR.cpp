@@ -175,6 +175,101 @@ float ::ADSR::Value(double time, const EventInfo* e) const
    return ofLerp(stageStartValue, mStages[stage].target * e->mMult, lerp);
 }
 
+void ::ADSR::Render(double time, double timeIncrement, float* output, int numSamples) const
+{
+   Renderer renderer(*this, time, timeIncrement);
+   renderer.Render(output, numSamples);
+}
+
+::ADSR::Renderer::Renderer(const ADSR& adsr, double time, double timeIncrement)
+: mAdsr(adsr)
+, mTime(time)
+, mTimeIncrement(timeIncrement)
+{
+   Update();
+}
+
+void ::ADSR::Renderer::Update()
+{
+   const double kNever = std::numeric_limits<double>::max();
+
+   mEvent = mAdsr.GetEventConst(mTime);
+
+   //another event takes over once we pass its start time
+   mNextEventTime = kNever;
+   for (const auto& event : mAdsr.mEvents)
+   {
+      if (event.mStartTime >= mTime && event.mStartTime < mNextEventTime)
+         mNextEventTime = event.mStartTime;
+   }
+
+   if (mAdsr.mHasSustainStage && mEvent->mStartTime >= 0 && mEvent->mStopTime > mEvent->mStartTime && mTime < mEvent->mStopTime)
+      mStopTime = mEvent->mStopTime;
+   else
+      mStopTime = kNever;
+
+   mStage = mAdsr.GetStage(mTime, mStageStartTime, mEvent);
+   if (mStage == mAdsr.mNumStages)
+   {
+      mStageEndTime = kNever;
+      mHoldTime = kNever;
+      return;
+   }
+
+   const Stage& stage = mAdsr.mStages[mStage];
+   mStageLength = stage.time * mAdsr.GetStageTimeScale(mStage);
+   mStageEndTime = mStageLength + mStageStartTime;
+   mHoldTime = kNever;
+   if (mAdsr.mHasSustainStage && mStage == mAdsr.mSustainStage)
+      mHoldTime = mStageEndTime;
+   if (mTime > mStageEndTime) //GetStage() stopped at the sustain stage, so we stay here until we're stopped
+      mStageEndTime = kNever;
+
+   if (mStage == 0)
+      mStageStartValue = mAdsr.mZeroValueIsFirstStage ? mAdsr.mStages[0].target : mEvent->mStartBlendFromValue;
+   else if (mAdsr.mHasSustainStage && mStage == mAdsr.mSustainStage + 1 && mEvent->mStopBlendFromValue != std::numeric_limits<float>::max())
+      mStageStartValue = mEvent->mStopBlendFromValue;
+   else
+      mStageStartValue = mAdsr.mStages[mStage - 1].target * mEvent->mMult;
+
+   mStageTarget = stage.target * mEvent->mMult;
+   mStageCurve = stage.curve + mAdsr.mCurve;
+   if (mStageStartValue >= mStageTarget)
+      mStageCurve = -mStageCurve;
+}
+
+float ::ADSR::Renderer::Next()
+{
+   if (mTime > mNextEventTime || mTime > mStageEndTime || mTime >= mStopTime)
+      Update();
+
+   float value;
+   if (mStage == mAdsr.mNumStages)
+   {
+      value = mAdsr.mStages[mStage - 1].target;
+   }
+   else if (mTime > mHoldTime)
+   {
+      value = mStageTarget;
+   }
+   else
+   {
+      float lerp = ofClamp((mTime - mStageStartTime) / mStageLength, 0, 1);
+      if (mStageCurve != 0)
+         lerp = MathUtils::Curve(lerp, mStageCurve);
+      value = ofLerp(mStageStartValue, mStageTarget, lerp);
+   }
+
+   mTime += mTimeIncrement;
+   return value;
+}
+
+void ::ADSR::Renderer::Render(float* output, int numSamples)
+{
+   for (int i = 0; i < numSamples; ++i)
+      output[i] = Next();
+}
+
 float ::ADSR::GetStageTimeScale(int stage) const
 {
    if (stage >= mNumStages - 1)
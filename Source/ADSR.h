@@ -70,6 +70,35 @@ public:
       double mStopTime{ -10000 };
    };
 
+   //steps through consecutive sample times, giving the same values as Value() would for each of them,
+   //but only looking up the event and stage when they could have changed
+   class Renderer
+   {
+   public:
+      Renderer(const ADSR& adsr, double time, double timeIncrement);
+      float Next();
+      void Render(float* output, int numSamples);
+      bool IsDone() const { return mStage == mAdsr.mNumStages; } //as of the last sample rendered
+
+   private:
+      void Update();
+
+      const ADSR& mAdsr;
+      double mTime{ 0 };
+      double mTimeIncrement{ 0 };
+      const EventInfo* mEvent{ nullptr };
+      double mNextEventTime{ 0 }; //the event could change once we're past this
+      double mStopTime{ 0 }; //the stage jumps to release once we reach this
+      int mStage{ 0 };
+      double mStageStartTime{ 0 };
+      double mStageEndTime{ 0 };
+      double mHoldTime{ 0 }; //sustain level is held once we're past this
+      float mStageLength{ 1 };
+      float mStageStartValue{ 0 };
+      float mStageTarget{ 0 };
+      float mStageCurve{ 0 };
+   };
+
    ADSR(float a, float d, float s, float r)
    {
       Set(a, d, s, r);
@@ -83,6 +112,7 @@ public:
    void Stop(double time, bool warn = true);
    float Value(double time) const;
    float Value(double time, const EventInfo* event) const;
+   void Render(double time, double timeIncrement, float* output, int numSamples) const;
    void Set(float a, float d, float s, float r, float h = -1);
    void Set(const ADSR& other);
    void Clear()
@@ -815,7 +815,10 @@ void AbletonMoveControl::DrawToFramebuffer()
       {
          auto* gain = trackRowToDisplay != nullptr ? trackRowToDisplay->GetGain() : nullptr;
          if (gain != nullptr)
+         {
             buffer = gain->GetVizBuffer();
+            buffer->MarkViewed();
+         }
       }
 
       if (mLissajousDisplayMode == LissajousDisplayMode::MixerTrack && trackRowToDisplay == nullptr)
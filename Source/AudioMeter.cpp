@@ -74,12 +74,9 @@ void AudioMeter::Process(double time)
    }
 
    for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-   {
-      Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize());
       GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
-   }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void AudioMeter::DrawModule()
@@ -26,6 +26,7 @@
 #include "BitcrushEffect.h"
 #include "OpenFrameworksPort.h"
 #include "SynthGlobals.h"
+#include "ModularSynth.h"
 #include "Profiler.h"
 #include "UIControlMacros.h"
 
@@ -39,7 +40,21 @@ void BitcrushEffect::CreateUIControls()
    UIBLOCK0();
    FLOATSLIDER(mCrushSlider, "crush", &mCrush, 1, 24);
    FLOATSLIDER_DIGITS(mDownsampleSlider, "downsamp", &mDownsample, 1, 40, 0);
+   DROPDOWN(mOversamplingDropdown, "oversample", &mOversampling, 40);
    ENDUIBLOCK(mWidth, mHeight);
+
+   Oversampler::FillDropdown(mOversamplingDropdown);
+}
+
+void BitcrushEffect::DropdownUpdated(DropdownList* list, int oldVal, double time)
+{
+   if (list == mOversamplingDropdown)
+   {
+      //setting up the oversamplers allocates, so do it here rather than on the audio thread, which waits for it
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "BitcrushEffect::DropdownUpdated()");
+      for (auto& oversampler : mOversamplers)
+         oversampler.Setup(mOversampling, gBufferSize);
+   }
 }
 
 void BitcrushEffect::ProcessAudio(double time, ChannelBuffer* buffer)
@@ -49,28 +64,39 @@ void BitcrushEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    if (!mEnabled)
       return;
 
-   float bufferSize = buffer->BufferSize();
+   int bufferSize = buffer->BufferSize();
+
+   const int oversampling = mOversamplers[0].GetFactor(); //what DropdownUpdated() set them up for
+   const int numSamples = bufferSize * oversampling;
 
    ComputeSliders(0);
 
    float bitDepth = powf(2, 25 - mCrush);
    float invBitDepth = 1.f / bitDepth;
+   int holdLength = (int)mDownsample * oversampling; //keep the held steps the same length in base rate samples
 
    for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
    {
-      for (int i = 0; i < bufferSize; ++i)
+      float* samples = buffer->GetChannel(ch);
+      if (oversampling > 1)
+         samples = mOversamplers[ch].Upsample(samples, bufferSize);
+
+      for (int i = 0; i < numSamples; ++i)
       {
-         if (mSampleCounter[ch] < (int)mDownsample - 1)
+         if (mSampleCounter[ch] < holdLength - 1)
          {
             ++mSampleCounter[ch];
          }
          else
          {
-            mHeldDownsample[ch] = buffer->GetChannel(ch)[i];
+            mHeldDownsample[ch] = samples[i];
             mSampleCounter[ch] = 0;
          }
-         buffer->GetChannel(ch)[i] = ((int)(mHeldDownsample[ch] * bitDepth)) * invBitDepth;
+         samples[i] = ((int)(mHeldDownsample[ch] * bitDepth)) * invBitDepth;
       }
+
+      if (oversampling > 1)
+         mOversamplers[ch].Downsample(samples, buffer->GetChannel(ch), bufferSize);
    }
 }
 
@@ -81,6 +107,7 @@ void BitcrushEffect::DrawModule()
 
    mDownsampleSlider->Draw();
    mCrushSlider->Draw();
+   mOversamplingDropdown->Draw();
 }
 
 float BitcrushEffect::GetEffectAmount()
@@ -28,8 +28,10 @@
 #include "IAudioEffect.h"
 #include "Slider.h"
 #include "Checkbox.h"
+#include "DropdownList.h"
+#include "Oversampler.h"
 
-class BitcrushEffect : public IAudioEffect, public IIntSliderListener, public IFloatSliderListener
+class BitcrushEffect : public IAudioEffect, public IIntSliderListener, public IFloatSliderListener, public IDropdownListener
 {
 public:
    BitcrushEffect();
@@ -43,11 +45,13 @@ public:
    void ProcessAudio(double time, ChannelBuffer* buffer) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
+   int GetLatencySamples() override { return mEnabled ? Oversampler::GetLatencySamples(mOversampling) : 0; }
    std::string GetType() override { return "bitcrush"; }
 
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
    void IntSliderUpdated(IntSlider* slider, int oldVal, double time) override;
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override;
+   void DropdownUpdated(DropdownList* list, int oldVal, double time) override;
 
    bool IsEnabled() const override { return mEnabled; }
 
@@ -61,4 +65,7 @@ private:
    float mHeldDownsample[ChannelBuffer::kMaxNumChannels]{};
    FloatSlider* mCrushSlider{ nullptr };
    FloatSlider* mDownsampleSlider{ nullptr };
+   int mOversampling{ 1 };
+   DropdownList* mOversamplingDropdown{ nullptr };
+   Oversampler mOversamplers[ChannelBuffer::kMaxNumChannels]{};
 };
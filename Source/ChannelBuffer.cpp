@@ -72,6 +72,7 @@ float* ChannelBuffer::GetChannel(int channel)
 {
    if (channel >= mActiveChannels)
       ofLog() << "error: requesting a higher channel index than we have active";
+   mCleared = false; //caller might write to it
    float* ret = mBuffers[MIN(channel, mActiveChannels - 1)];
    if (ret == nullptr)
    {
@@ -90,6 +91,7 @@ void ChannelBuffer::Clear() const
       if (mBuffers[i] != nullptr)
          ::Clear(mBuffers[i], BufferSize());
    }
+   mCleared = true;
 }
 
 void ChannelBuffer::SetMaxAllowedChannels(int channels)
@@ -119,6 +121,7 @@ void ChannelBuffer::CopyFrom(ChannelBuffer* src, int length /*= -1*/, int startO
       length = mBufferSize;
    assert(length <= mBufferSize);
    assert(length + startOffset <= src->mBufferSize);
+   mCleared = false;
    mActiveChannels = src->mActiveChannels;
    for (int i = 0; i < mActiveChannels; ++i)
    {
@@ -145,6 +148,31 @@ void ChannelBuffer::SetChannelPointer(float* data, int channel, bool deleteOldDa
    if (deleteOldData)
       delete[] mBuffers[channel];
    mBuffers[channel] = data;
+   mCleared = false;
+}
+
+bool ChannelBuffer::IsSilent(float threshold) const
+{
+   if (mCleared)
+      return true;
+   for (int i = 0; i < mActiveChannels; ++i)
+   {
+      if (mBuffers[i] != nullptr && GetPeak(mBuffers[i], mBufferSize) > threshold)
+         return false;
+   }
+   return true;
+}
+
+bool ChannelBuffer::CanSwapChannelData(const ChannelBuffer* other) const
+{
+   return other != this && mOwnsBuffers && other->mOwnsBuffers && mNumChannels == other->mNumChannels && mBufferSize == other->mBufferSize;
+}
+
+void ChannelBuffer::SwapChannelData(ChannelBuffer* other)
+{
+   assert(CanSwapChannelData(other));
+   std::swap(mBuffers, other->mBuffers);
+   std::swap(mCleared, other->mCleared);
 }
 
 void ChannelBuffer::Resize(int bufferSize)
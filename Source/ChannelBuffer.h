@@ -50,10 +50,15 @@ public:
    void SetChannelPointer(float* data, int channel, bool deleteOldData);
    void Reset()
    {
-      Clear();
+      if (!mCleared)
+         Clear();
       mRecentActiveChannels = mActiveChannels;
       SetNumActiveChannels(1);
    }
+   bool IsCleared() const { return mCleared; } //true if nothing has asked for a channel since the last Clear()
+   bool IsSilent(float threshold) const;
+   bool CanSwapChannelData(const ChannelBuffer* other) const;
+   void SwapChannelData(ChannelBuffer* other); //exchanges sample storage only, not channel counts
    void Resize(int bufferSize);
 
    enum class LoadMode
@@ -77,4 +82,5 @@ private:
    float** mBuffers;
    int mRecentActiveChannels{ 1 };
    bool mOwnsBuffers{ true };
+   mutable bool mCleared{ false };
 };
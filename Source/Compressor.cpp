@@ -69,6 +69,8 @@ void Compressor::CreateUIControls()
    mRatioSlider->SetMode(FloatSlider::kSquare);
    mAttackSlider->SetMode(FloatSlider::kSquare);
    mReleaseSlider->SetMode(FloatSlider::kSquare);
+   mAttackSlider->SetUpdateGranularity(FloatSlider::kUpdatePerBuffer); //recalculating the envelope coefficients every sample isn't worth it
+   mReleaseSlider->SetUpdateGranularity(FloatSlider::kUpdatePerBuffer);
    mLookaheadSlider->SetMode(FloatSlider::kSquare);
    mOutputAdjustSlider->SetMode(FloatSlider::kSquare);
 
@@ -66,6 +66,8 @@ void DelayEffect::CreateUIControls()
    mIntervalSelector->AddLabel("16nd", kInterval_16nd);
    mIntervalSelector->AddLabel("16n", kInterval_16n);
    mIntervalSelector->AddLabel("32n", kInterval_32n);
+
+   mDelaySlider->SetUpdateGranularity(FloatSlider::kUpdatePerBuffer); //only needs to hear about it to drop out of interval mode
 }
 
 void DelayEffect::ProcessAudio(double time, ChannelBuffer* buffer)
@@ -136,6 +138,22 @@ void DelayEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    }
 }
 
+float DelayEffect::GetTailLengthMs()
+{
+   if (!mEnabled)
+      return 0;
+   float feedback = fabsf(mFeedback);
+   if (feedback <= 0)
+      return 0;
+   float delay = MAX(mDelay, GetMinDelayMs());
+   if (!mEcho && mAcceptInput)
+      return delay; //single repeat
+   //echo, or input disabled (the delayed signal keeps getting written back into the buffer), so it decays by feedback per repeat
+   if (feedback >= .999f)
+      return -1;
+   return delay * MAX(1.0f, logf(.001f) / logf(feedback)); //number of repeats it takes to fall by 60dB
+}
+
 void DelayEffect::DrawModule()
 {
    if (!mEnabled)
@@ -57,6 +57,7 @@ public:
    void ProcessAudio(double time, ChannelBuffer* buffer) override;
    void SetEnabled(bool enabled) override;
    float GetEffectAmount() override;
+   float GetTailLengthMs() override;
    std::string GetType() override { return "delay"; }
 
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
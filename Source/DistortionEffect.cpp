@@ -26,6 +26,7 @@
 #include "DistortionEffect.h"
 #include "OpenFrameworksPort.h"
 #include "SynthGlobals.h"
+#include "ModularSynth.h"
 #include "Profiler.h"
 #include "UIControlMacros.h"
 
@@ -52,6 +53,7 @@ void DistortionEffect::CreateUIControls()
    FLOATSLIDER(mPreampSlider, "preamp", &mPreamp, 1, 10);
    FLOATSLIDER(mFuzzAmountSlider, "fuzz", &mFuzzAmount, -1, 1);
    CHECKBOX(mRemoveInputDCCheckbox, "center input", &mRemoveInputDC);
+   DROPDOWN(mOversamplingDropdown, "oversample", &mOversampling, 40);
    ENDUIBLOCK(mWidth, mHeight);
 
    mTypeDropdown->AddLabel("clean", kClean);
@@ -61,6 +63,19 @@ void DistortionEffect::CreateUIControls()
    mTypeDropdown->AddLabel("asym", kAsymmetric);
    mTypeDropdown->AddLabel("fold", kFold);
    mTypeDropdown->AddLabel("grungy", kGrungy);
+
+   Oversampler::FillDropdown(mOversamplingDropdown);
+}
+
+void DistortionEffect::DropdownUpdated(DropdownList* list, int oldVal, double time)
+{
+   if (list == mOversamplingDropdown)
+   {
+      //setting up the oversamplers allocates, so do it here rather than on the audio thread, which waits for it
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "DistortionEffect::DropdownUpdated()");
+      for (auto& oversampler : mOversamplers)
+         oversampler.Setup(mOversampling, gBufferSize);
+   }
 }
 
 void DistortionEffect::ProcessAudio(double time, ChannelBuffer* buffer)
@@ -70,7 +85,10 @@ void DistortionEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    if (!mEnabled)
       return;
 
-   float bufferSize = buffer->BufferSize();
+   int bufferSize = buffer->BufferSize();
+
+   const int oversampling = mOversamplers[0].GetFactor(); //what DropdownUpdated() set them up for
+   const int numSamples = bufferSize * oversampling;
 
    for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
    {
@@ -79,60 +97,64 @@ void DistortionEffect::ProcessAudio(double time, ChannelBuffer* buffer)
 
       mPeakTracker[ch].Process(buffer->GetChannel(ch), bufferSize);
 
+      float* samples = buffer->GetChannel(ch);
+      if (oversampling > 1)
+         samples = mOversamplers[ch].Upsample(samples, bufferSize);
+
       if (mType == kDirty)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            buffer->GetChannel(ch)[i] = (ofClamp((buffer->GetChannel(ch)[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain, -1, 1)) / mGain;
+            ComputeSliders(i / oversampling);
+            samples[i] = (ofClamp((samples[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain, -1, 1)) / mGain;
          }
       }
       else if (mType == kClean)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            buffer->GetChannel(ch)[i] = tanh((buffer->GetChannel(ch)[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain) / mGain;
+            ComputeSliders(i / oversampling);
+            samples[i] = tanh((samples[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain) / mGain;
          }
       }
       else if (mType == kWarm)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            buffer->GetChannel(ch)[i] = sin((buffer->GetChannel(ch)[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain) / mGain;
+            ComputeSliders(i / oversampling);
+            samples[i] = sin((samples[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain) / mGain;
          }
       }
       else if (mType == kGrungy)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            buffer->GetChannel(ch)[i] = asin(ofClamp((buffer->GetChannel(ch)[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain, -1, 1)) / mGain;
+            ComputeSliders(i / oversampling);
+            samples[i] = asin(ofClamp((samples[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain, -1, 1)) / mGain;
          }
       }
       //soft and asymmetric from http://www.music.mcgill.ca/~gary/courses/projects/618_2009/NickDonaldson/#Distortion
       else if (mType == kSoft)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            float sample = (buffer->GetChannel(ch)[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain;
+            ComputeSliders(i / oversampling);
+            float sample = (samples[i] + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain;
             if (sample > 1)
                sample = .66666f;
             else if (sample < -1)
                sample = -.66666f;
             else
                sample = sample - (sample * sample * sample) / 3.0f;
-            buffer->GetChannel(ch)[i] = sample / mGain;
+            samples[i] = sample / mGain;
          }
       }
       else if (mType == kAsymmetric)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            float sample = (buffer->GetChannel(ch)[i] * .5f + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain;
+            ComputeSliders(i / oversampling);
+            float sample = (samples[i] * .5f + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain;
             if (sample >= .320018f)
                sample = .630035f;
             else if (sample >= -.08905f)
@@ -141,15 +163,15 @@ void DistortionEffect::ProcessAudio(double time, ChannelBuffer* buffer)
                sample = -.75f * (1 - powf(1 - (fabsf(sample) - .032847f), 12) + .333f * (fabsf(sample) - .032847f)) + .01f;
             else
                sample = -.9818f;
-            buffer->GetChannel(ch)[i] = sample / mGain;
+            samples[i] = sample / mGain;
          }
       }
       else if (mType == kFold)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
-            float sample = ofClamp((buffer->GetChannel(ch)[i] * .5f + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain, -100, 100);
+            ComputeSliders(i / oversampling);
+            float sample = ofClamp((samples[i] * .5f + mFuzzAmount * mPeakTracker[ch].GetPeak()) * mPreamp * mGain, -100, 100);
             while (sample > 1 || sample < -1)
             {
                if (sample > 1)
@@ -157,9 +179,12 @@ void DistortionEffect::ProcessAudio(double time, ChannelBuffer* buffer)
                if (sample < -1)
                   sample = -2 - sample;
             }
-            buffer->GetChannel(ch)[i] = sample / mGain;
+            samples[i] = sample / mGain;
          }
       }
+
+      if (oversampling > 1)
+         mOversamplers[ch].Downsample(samples, buffer->GetChannel(ch), bufferSize);
    }
 }
 
@@ -179,6 +204,7 @@ void DistortionEffect::DrawModule()
    mPreampSlider->Draw();
    mRemoveInputDCCheckbox->Draw();
    mFuzzAmountSlider->Draw();
+   mOversamplingDropdown->Draw();
 }
 
 float DistortionEffect::GetEffectAmount()
@@ -31,6 +31,7 @@
 #include "DropdownList.h"
 #include "BiquadFilter.h"
 #include "PeakTracker.h"
+#include "Oversampler.h"
 
 class DistortionEffect : public IAudioEffect, public IFloatSliderListener, public IDropdownListener
 {
@@ -48,11 +49,12 @@ public:
    void ProcessAudio(double time, ChannelBuffer* buffer) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
+   int GetLatencySamples() override { return mEnabled ? Oversampler::GetLatencySamples(mOversampling) : 0; }
    std::string GetType() override { return "distortion"; }
 
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override;
-   void DropdownUpdated(DropdownList* list, int oldVal, double time) override {}
+   void DropdownUpdated(DropdownList* list, int oldVal, double time) override;
 
    bool IsEnabled() const override { return mEnabled; }
 
@@ -77,12 +79,15 @@ private:
    float mPreamp{ 1 };
    float mFuzzAmount{ 0 };
    bool mRemoveInputDC{ false };
+   int mOversampling{ 1 };
 
    DropdownList* mTypeDropdown{ nullptr };
    FloatSlider* mClipSlider{ nullptr };
    FloatSlider* mPreampSlider{ nullptr };
    Checkbox* mRemoveInputDCCheckbox{ nullptr };
    FloatSlider* mFuzzAmountSlider{ nullptr };
+   DropdownList* mOversamplingDropdown{ nullptr };
    BiquadFilter mDCRemover[ChannelBuffer::kMaxNumChannels]{};
    PeakTracker mPeakTracker[ChannelBuffer::kMaxNumChannels]{};
+   Oversampler mOversamplers[ChannelBuffer::kMaxNumChannels]{};
 };
@@ -393,11 +393,15 @@ bool DrumPlayer::DrumHit::Process(double time, float speed, float vol, ChannelBu
    ChannelBuffer* sampleData = mSample.Data();
    speed *= mSpeed;
 
+   ModulationBlock pitchBend;
+   if (mPitchBend != nullptr)
+      pitchBend = mPitchBend->GetBlock();
+
    for (int i = 0; i < bufferSize; ++i)
    {
       float sampleSpeed = speed;
       if (mPitchBend != nullptr)
-         sampleSpeed *= ofMap(mPitchBend->GetValue(i), -.5f, .5f, 0, 2);
+         sampleSpeed *= ofMap(pitchBend[i], -.5f, .5f, 0, 2);
 
       for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
          gWorkBuffer[ch] = 0;
@@ -387,18 +387,24 @@ void DrumSynth::DrumSynthHit::Process(double time, float* out, int bufferSize, i
       return;
    }
 
+   ::ADSR::Renderer freqAdsr(mData.mFreqAdsr, time, sampleIncrementMs);
+   ::ADSR::Renderer filterAdsr(mData.mFilterAdsr, time, sampleIncrementMs);
+   ::ADSR::Renderer toneAdsr(*mData.mTone.GetADSR(), time, sampleIncrementMs);
+   ::ADSR::Renderer noiseAdsr(*mData.mNoise.GetADSR(), time, sampleIncrementMs);
+
    for (size_t i = 0; i < bufferSize; ++i)
    {
-      float freq = ofLerp(mData.mFreqMin, mData.mFreqMax, mData.mFreqAdsr.Value(time));
+      float freq = ofLerp(mData.mFreqMin, mData.mFreqMax, freqAdsr.Next());
+      float filterAdsrVal = filterAdsr.Next();
       if (mData.mCutoffMax != DRUMSYNTH_NO_CUTOFF)
       {
          mFilter.SetSampleRate(sampleRate);
-         mFilter.SetFilterParams(ofLerp(mData.mCutoffMin, mData.mCutoffMax, mData.mFilterAdsr.Value(time)), mData.mQ);
+         mFilter.SetFilterParams(ofLerp(mData.mCutoffMin, mData.mCutoffMax, filterAdsrVal), mData.mQ);
       }
       float phaseInc = GetPhaseInc(freq) / oversampling;
 
-      float sample = mData.mTone.Audio(time, mPhase) * mData.mVol * mData.mVol;
-      float noise = mData.mNoise.Audio(time, mPhase);
+      float sample = mData.mTone.mOsc.Value(mPhase) * toneAdsr.Next() * mData.mVol * mData.mVol;
+      float noise = mData.mNoise.mOsc.Value(mPhase) * noiseAdsr.Next();
       noise *= noise * (noise > 0 ? 1 : -1); //square but keep sign
       sample += noise * mData.mVolNoise * mData.mVolNoise;
       if (mData.mCutoffMax != DRUMSYNTH_NO_CUTOFF)
@@ -411,8 +417,6 @@ void DrumSynth::DrumSynthHit::Process(double time, float* out, int bufferSize, i
       {
          mPhase -= FTWO_PI;
       }
-
-      time += sampleIncrementMs;
    }
 }
 
@@ -28,6 +28,10 @@
 #include "SynthGlobals.h"
 #include "ModularSynth.h"
 #include "Profiler.h"
+#include "RollingBuffer.h"
+#include "Oversampler.h"
+
+#include <chrono>
 
 const double gSwapLength = 150.0;
 
@@ -41,6 +45,8 @@ EffectChain::~EffectChain()
 {
    for (int i = 0; i < mEffects.size(); ++i)
       delete mEffects[i];
+   for (auto& controls : mEffectControls)
+      delete controls.mDryDelay;
 }
 
 void EffectChain::CreateUIControls()
@@ -93,13 +99,10 @@ void EffectChain::AddEffect(std::string type, std::string desiredName, bool onTh
    if (mInitialized) //if we've already been initialized, call init on this
       effect->Init();
 
-   mEffectMutex.lock();
-   mEffects.push_back(effect);
-   mEffectMutex.unlock();
-   AddChild(effect);
-
-   float* dryWet = &(mDryWetLevels[mEffects.size() - 1]);
+   int index = (int)mEffects.size();
+   float* dryWet = &(mDryWetLevels[index]);
    *dryWet = 1;
+   mEffectCpuUsage[index] = 0;
 
    EffectControls controls;
    controls.mMoveLeftButton = new ClickButton(this, "<", 0, 0);
@@ -108,11 +111,25 @@ void EffectChain::AddEffect(std::string type, std::string desiredName, bool onTh
    controls.mMoveRightButton->SetCableTargetable(false);
    controls.mDeleteButton = new ClickButton(this, "x", 0, 0);
    controls.mDeleteButton->SetCableTargetable(false);
-   controls.mDryWetSlider = new FloatSlider(this, ("mix" + ofToString(mEffects.size() - 1)).c_str(), 0, 0, 60, 13, dryWet, 0, 1, 2);
+   controls.mDryWetSlider = new FloatSlider(this, ("mix" + ofToString(index)).c_str(), 0, 0, 60, 13, dryWet, 0, 1, 2);
    controls.mPush2DisplayEffectButton = new ClickButton(this, ("edit " + name).c_str(), 0, 0);
    controls.mPush2DisplayEffectButton->SetShowing(false);
    controls.mPush2DisplayEffectButton->SetCableTargetable(false);
+   controls.mDryDelay = new RollingBuffer(gBufferSize + Oversampler::GetLatencySamples(Oversampler::kMaxFactor) + 1);
+
+   //the audio thread reads the mix slider for each effect, so these need to change together
+   mEffectMutex.lock();
+   mEffects.push_back(effect);
    mEffectControls.push_back(controls);
+   mEffectMutex.unlock();
+   AddChild(effect);
+}
+
+float EffectChain::GetTailLengthMs()
+{
+   if (!mEnabled)
+      return 0;
+   return mTailLengthMs; //updated in Poll(), so the audio thread doesn't have to take mEffectMutex for this
 }
 
 void EffectChain::Process(double time)
@@ -132,27 +149,39 @@ void EffectChain::Process(double time)
    {
       mEffectMutex.lock();
 
+      const double bufferDurationNs = bufferSize / double(gSampleRate) * 1000000000;
       for (int i = 0; i < mEffects.size(); ++i)
       {
-         mDryBuffer.CopyFrom(GetBuffer());
-
-         mEffects[i]->ProcessAudio(time, GetBuffer());
-
-         float* dryWetBuffer = gWorkBuffer;
-         float* invDryWetBuffer = gWorkBuffer + bufferSize;
-         for (int j = 0; j < bufferSize; ++j)
+         bool modulatedMix = mEffectControls[i].mDryWetSlider->IsChangingOverTime();
+         float mix = mDryWetLevels[i];
+         bool bypassed = !modulatedMix && mix == 0;
+         bool fullyWet = !modulatedMix && mix == 1;
+
+         //an effect that reports latency gets its dry signal delayed to match. keep that fed whatever the mix, so it has the right
+         //history when the mix changes
+         if (mEffects[i]->GetLatencySamples() > 0)
          {
-            ComputeSliders(j);
-            dryWetBuffer[j] = mDryWetLevels[i];
-            invDryWetBuffer[j] = 1.0f - mDryWetLevels[i];
+            RollingBuffer* dryDelay = mEffectControls[i].mDryDelay;
+            for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+               dryDelay->WriteChunk(GetBuffer()->GetChannel(ch), bufferSize, ch);
          }
 
-         for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+         if (bypassed)
          {
-            Mult(mDryBuffer.GetChannel(ch), invDryWetBuffer, bufferSize);
-            Mult(GetBuffer()->GetChannel(ch), dryWetBuffer, bufferSize);
-            Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+            mEffectCpuUsage[i] *= .95f;
+            continue;
          }
+
+         if (!fullyWet)
+            mDryBuffer.CopyFrom(GetBuffer());
+
+         auto startTime = std::chrono::steady_clock::now();
+         mEffects[i]->ProcessAudio(time, GetBuffer());
+         auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+         mEffectCpuUsage[i] = ofLerp(mEffectCpuUsage[i], float(elapsedNs / bufferDurationNs), .05f);
+
+         if (!fullyWet)
+            ApplyDryWet(i, bufferSize);
       }
 
       mEffectMutex.unlock();
@@ -167,11 +196,53 @@ void EffectChain::Process(double time)
          for (int i = 0; i < bufferSize; ++i)
             buffer[i] *= volSq;
       }
-      Add(target->GetBuffer()->GetChannel(ch), buffer, bufferSize);
       GetVizBuffer()->WriteChunk(buffer, bufferSize, ch);
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
+}
+
+//mixes mDryBuffer back in under effect slot index's output
+void EffectChain::ApplyDryWet(int index, int bufferSize)
+{
+   int latency = mEffects[index]->GetLatencySamples();
+   if (latency > 0)
+   {
+      RollingBuffer* dryDelay = mEffectControls[index].mDryDelay;
+      latency = MIN(latency, dryDelay->Size() - bufferSize - 1);
+      for (int ch = 0; ch < mDryBuffer.NumActiveChannels(); ++ch)
+         dryDelay->ReadChunk(mDryBuffer.GetChannel(ch), bufferSize, latency, ch); //Process() already wrote this buffer's dry signal
+   }
+
+   FloatSlider* mixSlider = mEffectControls[index].mDryWetSlider;
+   if (mixSlider->IsChangingOverTime())
+   {
+      float* dryWetBuffer = gWorkBuffer;
+      float* invDryWetBuffer = gWorkBuffer + bufferSize;
+      for (int j = 0; j < bufferSize; ++j)
+      {
+         mixSlider->Compute(j);
+         dryWetBuffer[j] = mDryWetLevels[index];
+         invDryWetBuffer[j] = 1.0f - mDryWetLevels[index];
+      }
+
+      for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+      {
+         Mult(mDryBuffer.GetChannel(ch), invDryWetBuffer, bufferSize);
+         Mult(GetBuffer()->GetChannel(ch), dryWetBuffer, bufferSize);
+         Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+      }
+   }
+   else
+   {
+      float mix = mDryWetLevels[index];
+      for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+      {
+         Mult(mDryBuffer.GetChannel(ch), 1.0f - mix, bufferSize);
+         Mult(GetBuffer()->GetChannel(ch), mix, bufferSize);
+         Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+      }
+   }
 }
 
 void EffectChain::Poll()
@@ -181,6 +252,32 @@ void EffectChain::Poll()
       DeleteEffect(mWantToDeleteEffectAtIndex);
       mWantToDeleteEffectAtIndex = -1;
    }
+
+   int latencySamples = 0;
+   float tailLengthMs = 0;
+   if (mEnabled)
+   {
+      mEffectMutex.lock();
+      for (int i = 0; i < (int)mEffects.size(); ++i)
+      {
+         bool bypassed = mDryWetLevels[i] == 0 && !mEffectControls[i].mDryWetSlider->IsChangingOverTime();
+         if (!bypassed)
+            latencySamples += mEffects[i]->GetLatencySamples();
+
+         float effectTail = mEffects[i]->GetTailLengthMs();
+         if (effectTail < 0 || tailLengthMs < 0)
+            tailLengthMs = -1;
+         else
+            tailLengthMs += effectTail; //effects are in series, so each one can ring on after the previous one's tail
+      }
+      mEffectMutex.unlock();
+   }
+   mTailLengthMs = tailLengthMs;
+   if (latencySamples != mLatencySamples)
+   {
+      mLatencySamples = latencySamples;
+      TheSynth->ArrangeAudioSourceDependencies();
+   }
 }
 
 void EffectChain::DrawModule()
@@ -251,6 +348,14 @@ void EffectChain::DrawModule()
          ofPopStyle();
       }
 
+      if (Profiler::IsEnabled())
+      {
+         ofPushStyle();
+         ofSetColor(255, 255, 255, 150);
+         DrawTextRightJustify(ofToString(mEffectCpuUsage[i] * 100, 1) + "% cpu", x + w - 2, y + h - 3, 10);
+         ofPopStyle();
+      }
+
       if (i < mEffects.size() - 1)
       {
          ofPushMatrix();
@@ -387,6 +492,8 @@ void EffectChain::DeleteEffect(int index)
 {
    assert(!mEffects.empty());
 
+   mEffectMutex.lock(); //the audio thread expects mEffects and mEffectControls to line up
+
    {
       RemoveUIControl(mEffectControls[index].mMoveLeftButton);
       RemoveUIControl(mEffectControls[index].mMoveRightButton);
@@ -398,6 +505,7 @@ void EffectChain::DeleteEffect(int index)
       mEffectControls[index].mDeleteButton->Delete();
       mEffectControls[index].mDryWetSlider->Delete();
       mEffectControls[index].mPush2DisplayEffectButton->Delete();
+      delete mEffectControls[index].mDryDelay;
       //remove the element from mEffectControls
       int i = 0;
       for (auto iter = mEffectControls.begin(); iter != mEffectControls.end(); ++iter)
@@ -417,13 +525,15 @@ void EffectChain::DeleteEffect(int index)
    }
 
    {
-      mEffectMutex.lock();
       IAudioEffect* toRemove = mEffects[index];
       RemoveFromVector(toRemove, mEffects);
+      std::copy(mEffectCpuUsage.begin() + index + 1, mEffectCpuUsage.end(), mEffectCpuUsage.begin() + index); //keep each slot's readout with its effect
+      mEffectCpuUsage.back() = 0;
       RemoveChild(toRemove);
       //delete toRemove;   TODO(Ryan) can't do this in case stuff is referring to its UI controls
-      mEffectMutex.unlock();
    }
+
+   mEffectMutex.unlock();
 }
 
 void EffectChain::MoveEffect(int fromIndex, int direction)
@@ -442,15 +552,17 @@ void EffectChain::MoveEffect(int fromIndex, int direction)
       IAudioEffect* swap = mEffects[newIndex];
       mEffects[newIndex] = mEffects[fromIndex];
       mEffects[fromIndex] = swap;
-      mEffectMutex.unlock();
 
       float level = mDryWetLevels[newIndex];
       mDryWetLevels[newIndex] = mDryWetLevels[fromIndex];
       mDryWetLevels[fromIndex] = level;
 
+      std::swap(mEffectCpuUsage[newIndex], mEffectCpuUsage[fromIndex]);
+
       FloatSlider* dryWetSlider = mEffectControls[newIndex].mDryWetSlider;
       mEffectControls[newIndex].mDryWetSlider = mEffectControls[fromIndex].mDryWetSlider;
       mEffectControls[fromIndex].mDryWetSlider = dryWetSlider;
+      mEffectMutex.unlock();
 
       ClickButton* displayButton = mEffectControls[newIndex].mPush2DisplayEffectButton;
       mEffectControls[newIndex].mPush2DisplayEffectButton = mEffectControls[fromIndex].mPush2DisplayEffectButton;
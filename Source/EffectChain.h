@@ -36,6 +36,7 @@
 #define MIN_EFFECT_WIDTH 80
 
 class IAudioEffect;
+class RollingBuffer;
 
 class EffectChain : public IDrawableModule, public IAudioProcessor, public IButtonListener, public IFloatSliderListener, public IDropdownListener
 {
@@ -57,6 +58,8 @@ public:
 
    //IAudioSource
    void Process(double time) override;
+   float GetTailLengthMs() override;
+   int GetLatencySamples() override { return mLatencySamples; }
 
    void KeyPressed(int key, bool isRepeat) override;
    void KeyReleased(int key) override;
@@ -88,6 +91,7 @@ private:
    void DeleteEffect(int index);
    void MoveEffect(int index, int direction);
    void UpdateReshuffledDryWetSliders();
+   void ApplyDryWet(int index, int bufferSize);
    ofVec2f GetEffectPos(int index) const;
 
    struct EffectControls
@@ -97,12 +101,14 @@ private:
       ClickButton* mDeleteButton{ nullptr };
       FloatSlider* mDryWetSlider{ nullptr };
       ClickButton* mPush2DisplayEffectButton{ nullptr };
+      RollingBuffer* mDryDelay{ nullptr }; //holds the dry signal back to line up with effects that report latency
    };
 
    std::vector<IAudioEffect*> mEffects{};
    ChannelBuffer mDryBuffer;
    std::vector<EffectControls> mEffectControls;
    std::array<float, MAX_EFFECTS_IN_CHAIN> mDryWetLevels{};
+   std::array<float, MAX_EFFECTS_IN_CHAIN> mEffectCpuUsage{}; //smoothed fraction of each buffer's duration spent in each slot
 
    double mSwapTime{ -1 };
    int mSwapFromIdx{ -1 };
@@ -116,6 +122,8 @@ private:
    bool mShowSpawnList{ true };
    int mWantToDeleteEffectAtIndex{ -1 };
    IAudioEffect* mPush2DisplayEffect{ nullptr };
+   int mLatencySamples{ 0 };
+   float mTailLengthMs{ 0 };
 
    std::vector<std::string> mEffectTypesToSpawn;
    int mSpawnIndex{ -1 };
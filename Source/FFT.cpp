@@ -275,7 +275,8 @@ static REAL sintab[20] = {
    .00009587379909597734587051721097647635118706561284,
    .00004793689960306688454900399049465887274686668768
 };
-static REAL coswrk[20] = {
+//scratch for TRIG_NEXT, reset from costab/sintab by TRIG_INIT. per thread, so transforms can run on more than one thread at once.
+static thread_local REAL coswrk[20] = {
    .00000000000000000000000000000000000000000000000000,
    .70710678118654752440084436210484903928483593768847,
    .92387953251128675612818318939678828682241662586364,
@@ -293,7 +294,7 @@ static REAL coswrk[20] = {
    .99999999540410731289097193313960614895889430318945,
    .99999999885102682756267330779455410840053741619428
 };
-static REAL sinwrk[20] = {
+static thread_local REAL sinwrk[20] = {
    1.0000000000000000000000000000000000000000000000000,
    .70710678118654752440084436210484903928483593768846,
    .38268343236508977172845998403039886676134456248561,
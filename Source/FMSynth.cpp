@@ -133,6 +133,15 @@ void FMSynth::Process(double time)
 
    mNoteInputBuffer.Process(time);
 
+   if (mPolyMgr.IsIdle())
+   {
+      //leave our target untouched, so that it stays flagged as silent and downstream effects can sleep. the visualization still
+      //needs to show the silence though, or our cables keep drawing the last buffer we played.
+      for (int ch = 0; ch < mWriteBuffer.NumActiveChannels(); ++ch)
+         GetVizBuffer()->WriteChunk(gZeroBuffer, gBufferSize, ch);
+      return;
+   }
+
    ComputeSliders(0);
 
    int bufferSize = target->GetBuffer()->BufferSize();
@@ -52,28 +52,27 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
    if (IsDone(time))
       return false;
 
-   int bufferSize = out->BufferSize();
+   int bufferSize = out->BufferSize(); //already oversampled, PolyphonyMgr filters it back down
    int channels = out->NumActiveChannels();
-   double sampleIncrementMs = gInvSampleRateMs;
-   ChannelBuffer* destBuffer = out;
+   double sampleIncrementMs = gInvSampleRateMs / oversampling;
 
-   if (oversampling != 1)
-   {
-      gMidiVoiceWorkChannelBuffer.SetNumActiveChannels(channels);
-      destBuffer = &gMidiVoiceWorkChannelBuffer;
-      gMidiVoiceWorkChannelBuffer.Clear();
-      bufferSize *= oversampling;
-      sampleIncrementMs /= oversampling;
-   }
+   ::ADSR::Renderer oscEnvelope(*mOsc.GetADSR(), time, sampleIncrementMs);
+   ::ADSR::Renderer harmEnvelope(*mHarm.GetADSR(), time, sampleIncrementMs);
+   ::ADSR::Renderer harmEnvelope2(*mHarm2.GetADSR(), time, sampleIncrementMs);
+   ::ADSR::Renderer modIdxEnvelope(mModIdx, time, sampleIncrementMs);
+   ::ADSR::Renderer modIdxEnvelope2(mModIdx2, time, sampleIncrementMs);
 
    for (int pos = 0; pos < bufferSize; ++pos)
    {
       if (mOwner)
          mOwner->ComputeSliders(pos / oversampling);
 
-      float oscFreq = TheScale->PitchToFreq(GetPitch(pos / oversampling));
-      float harmFreq = oscFreq * mHarm.GetADSR()->Value(time) * mVoiceParams->mHarmRatio;
-      float harmFreq2 = harmFreq * mHarm2.GetADSR()->Value(time) * mVoiceParams->mHarmRatio2;
+      float harmEnvelopeValue = harmEnvelope.Next();
+      float harmEnvelopeValue2 = harmEnvelope2.Next();
+
+      float oscFreq = GetFreq(pos / oversampling);
+      float harmFreq = oscFreq * harmEnvelopeValue * mVoiceParams->mHarmRatio;
+      float harmFreq2 = harmFreq * harmEnvelopeValue2 * mVoiceParams->mHarmRatio2;
 
       float harmPhaseInc2 = GetPhaseInc(harmFreq2) / oversampling;
 
@@ -83,7 +82,7 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
          mHarmPhase2 -= FTWO_PI;
       }
 
-      float modHarmFreq = harmFreq + mHarm2.Audio(time, mHarmPhase2 + mVoiceParams->mPhaseOffset2) * harmFreq2 * mModIdx2.Value(time) * mVoiceParams->mModIdx2;
+      float modHarmFreq = harmFreq + mHarm2.mOsc.Value(mHarmPhase2 + mVoiceParams->mPhaseOffset2) * harmEnvelopeValue2 * harmFreq2 * modIdxEnvelope2.Next() * mVoiceParams->mModIdx2;
 
       float harmPhaseInc = GetPhaseInc(modHarmFreq) / oversampling;
 
@@ -93,7 +92,7 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
          mHarmPhase -= FTWO_PI;
       }
 
-      float modOscFreq = oscFreq + mHarm.Audio(time, mHarmPhase + mVoiceParams->mPhaseOffset1) * harmFreq * mModIdx.Value(time) * mVoiceParams->mModIdx;
+      float modOscFreq = oscFreq + mHarm.mOsc.Value(mHarmPhase + mVoiceParams->mPhaseOffset1) * harmEnvelopeValue * harmFreq * modIdxEnvelope.Next() * mVoiceParams->mModIdx;
       float oscPhaseInc = GetPhaseInc(modOscFreq) / oversampling;
 
       mOscPhase += oscPhaseInc;
@@ -102,36 +101,16 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
          mOscPhase -= FTWO_PI;
       }
 
-      float sample = mOsc.Audio(time, mOscPhase + mVoiceParams->mPhaseOffset0) * mVoiceParams->mVol / 20.0f;
+      float sample = mOsc.mOsc.Value(mOscPhase + mVoiceParams->mPhaseOffset0) * oscEnvelope.Next() * mVoiceParams->mVol / 20.0f;
       if (channels == 1)
       {
-         destBuffer->GetChannel(0)[pos] += sample;
+         out->GetChannel(0)[pos] += sample;
       }
       else
       {
-         destBuffer->GetChannel(0)[pos] += sample * GetLeftPanGain(GetPan());
-         destBuffer->GetChannel(1)[pos] += sample * GetRightPanGain(GetPan());
-      }
-
-      time += sampleIncrementMs;
-   }
-
-   if (oversampling != 1)
-   {
-      //assume power-of-two
-      while (oversampling > 1)
-      {
-         for (int i = 0; i < bufferSize; ++i)
-         {
-            for (int ch = 0; ch < channels; ++ch)
-               destBuffer->GetChannel(ch)[i] = (destBuffer->GetChannel(ch)[i * 2] + destBuffer->GetChannel(ch)[i * 2 + 1]) / 2;
-         }
-         oversampling /= 2;
-         bufferSize /= 2;
+         out->GetChannel(0)[pos] += sample * GetLeftPanGain(GetPan());
+         out->GetChannel(1)[pos] += sample * GetRightPanGain(GetPan());
       }
-
-      for (int ch = 0; ch < channels; ++ch)
-         Add(out->GetChannel(ch), destBuffer->GetChannel(ch), bufferSize);
    }
 
    return true;
@@ -78,6 +78,19 @@ void FreeverbEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    mFreeverb.processreplace(buffer->GetChannel(0), buffer->GetChannel(secondChannel), buffer->GetChannel(0), buffer->GetChannel(secondChannel), bufferSize, 1);
 }
 
+float FreeverbEffect::GetTailLengthMs()
+{
+   if (!mEnabled)
+      return 0;
+   if (mFreeze)
+      return -1;
+   //the comb filter feedback is offsetroom + room size * scaleroom (see freeverb's tuning.h), so the longest comb tells us how long it takes to fall by 60dB
+   const float kLongestCombSamples = 1617 + 23;
+   float combMs = kLongestCombSamples / gSampleRate * 1000;
+   float feedback = .7f + .28f * ofClamp(mRoomSize, 0, 1);
+   return combMs * logf(.001f) / logf(feedback);
+}
+
 void FreeverbEffect::DrawModule()
 {
    if (!mEnabled)
@@ -45,6 +45,7 @@ public:
    void ProcessAudio(double time, ChannelBuffer* buffer) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
+   float GetTailLengthMs() override;
    std::string GetType() override { return "freeverb"; }
 
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
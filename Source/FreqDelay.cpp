@@ -72,11 +72,10 @@ void FreqDelay::Process(double time)
       Mult(mDryBuffer.GetChannel(ch), (1 - mDryWet), bufferSize);
       Mult(GetBuffer()->GetChannel(ch), mDryWet, bufferSize);
       Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
-      Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), bufferSize);
       GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), bufferSize, ch);
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void FreqDelay::PlayNote(NoteMessage note)
@@ -45,6 +45,7 @@ public:
 
    //IAudioSource
    void Process(double time) override;
+   float GetTailLengthMs() override { return mDelayEffect.GetTailLengthMs(); }
 
    //INoteReceiver
    void PlayNote(NoteMessage note) override;
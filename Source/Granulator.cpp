@@ -82,13 +82,30 @@ void Granulator::ProcessFrame(double time, ChannelBuffer* buffer, int bufferLeng
    if (mSpawnGrains)
       SpawnGrainIfReady(time, mNextGrainSpawnMs, buffer, offset, speed);
 
-   for (int i = 0; i < MAX_GRAINS; ++i)
-      mGrains[i].Process(time, buffer, bufferLength, output, this);
+   for (int i = 0; i < mNumActiveGrains;)
+   {
+      int grainIdx = mActiveGrains[i];
+      if (mGrains[grainIdx].Process(time, buffer, bufferLength, output, this))
+      {
+         ++i;
+      }
+      else
+      {
+         mGrainIsActive[grainIdx] = false;
+         --mNumActiveGrains;
+         mActiveGrains[i] = mActiveGrains[mNumActiveGrains];
+      }
+   }
 
+   //lower volume on dense granulation, starting at 4 overlap. past DENSE_GRAIN_OVERLAP the grains add up like noise, so keep falling by the square root
+   float densityGain = 1;
+   if (mGrainOverlap > DENSE_GRAIN_OVERLAP)
+      densityGain = .5f * sqrtf(DENSE_GRAIN_OVERLAP / mGrainOverlap);
+   else if (mGrainOverlap > 4)
+      densityGain = ofMap(mGrainOverlap, DENSE_GRAIN_OVERLAP, 4, .5f, 1);
    for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
    {
-      if (mGrainOverlap > 4)
-         output[ch] *= ofMap(mGrainOverlap, MAX_GRAINS, 4, .5f, 1); //lower volume on dense granulation, starting at 4 overlap
+      output[ch] *= densityGain;
       output[ch] = mBiquad[ch].Filter(output[ch]);
    }
 }
@@ -133,6 +150,12 @@ void Granulator::SpawnGrain(double time, double offset, float width, float speed
    }
    offset += ofRandom(-mPosRandomizeMs, mPosRandomizeMs) / gInvSampleRateMs;
    mGrains[mNextGrainIdx].Spawn(time, offset, speedMult, mGrainLengthMs, vol, width);
+   if (!mGrainIsActive[mNextGrainIdx])
+   {
+      mGrainIsActive[mNextGrainIdx] = true;
+      mActiveGrains[mNumActiveGrains] = mNextGrainIdx;
+      ++mNumActiveGrains;
+   }
 
    mNextGrainIdx = (mNextGrainIdx + 1) % MAX_GRAINS;
    mNextGrainSpawnMs = time + mGrainLengthMs * 1 / mGrainOverlap * ofRandom(1 - mSpacingRandomize / 2, 1 + mSpacingRandomize / 2);
@@ -198,6 +221,63 @@ namespace
 
       return cos_approx;
    }
+
+   //the curved windows only depend on shape through a phase warp, so the curves themselves can be tabulated once
+   struct GrainWindowTables
+   {
+      static constexpr int kSize = 1024;
+
+      GrainWindowTables()
+      {
+         for (int i = 0; i <= kSize; ++i)
+         {
+            double phase = double(i) / kSize;
+            mRound[i] = float(.5 + .5 * cos(phase * TWO_PI - PI));
+            mFast[i] = float(FastCosWindow(phase));
+         }
+      }
+
+      static float Lookup(const float* table, float phase)
+      {
+         float index = phase * kSize;
+         if (!(index >= 0)) //also catches nan
+            index = 0;
+         if (index > kSize - 1)
+            index = kSize - 1;
+         int i = int(index);
+         float a = index - i;
+         return table[i] + a * (table[i + 1] - table[i]);
+      }
+
+      float mRound[kSize + 1]{};
+      float mFast[kSize + 1]{};
+   };
+
+   const GrainWindowTables& GetGrainWindowTables()
+   {
+      static const GrainWindowTables sTables;
+      return sTables;
+   }
+
+   const GrainWindowTables& sGrainWindowTablesInit = GetGrainWindowTables(); //build at startup rather than on the audio thread
+}
+
+inline float Granulator::GetWindowFast(GrainWindowType type, float shape, float grainLengthMs, float phase)
+{
+   if (type == GrainWindowType::Round || type == GrainWindowType::Fast)
+   {
+      if (phase < shape)
+         phase = phase / shape * 0.5f;
+      else
+         phase = (phase - shape) / (1.0f - shape) * 0.5f + 0.5f;
+      const GrainWindowTables& tables = GetGrainWindowTables();
+      return GrainWindowTables::Lookup(type == GrainWindowType::Round ? tables.mRound : tables.mFast, phase);
+   }
+   else if (type == GrainWindowType::Hybrid)
+   {
+      return (GetWindowFast(GrainWindowType::Round, 0.5f, grainLengthMs, phase) + GetWindowFast(GrainWindowType::Envelope, shape, grainLengthMs, phase)) * 0.5f;
+   }
+   return (float)GetWindow(type, shape, grainLengthMs, phase); //the straight-line windows are already cheap
 }
 
 inline double Granulator::GetWindow(GrainWindowType type, double shape, double grainLengthMs, double phase)
@@ -256,19 +336,50 @@ void Grain::Spawn(double time, double pos, float speedMult, float lengthInMs, fl
    mDrawPos = ofRandom(1);
 }
 
-void Grain::Process(double time, ChannelBuffer* buffer, int bufferLength, float* output, const Granulator* granulator)
+//returns false once the grain is finished
+bool Grain::Process(double time, ChannelBuffer* buffer, int bufferLength, float* output, const Granulator* granulator)
 {
-   if (time >= mStartTime && time <= mEndTime && mVol != 0)
+   if (mVol == 0 || time > mEndTime)
+      return false;
+
+   if (time >= mStartTime)
    {
       mPos += mSpeedMult * granulator->mSpeed;
-      double phase = (time - mStartTime) * mStartToEndInv;
-      double window = Granulator::GetWindow(granulator->mWindowType, granulator->mWindowShape, granulator->mGrainLengthMs, phase);
-      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+      float phase = float((time - mStartTime) * mStartToEndInv);
+      float gain = Granulator::GetWindowFast(granulator->mWindowType, granulator->mWindowShape, granulator->mGrainLengthMs, phase) * mVol;
+
+      //find the read position once for all channels, rather than once per channel per blended channel
+      double offset = DoubleWrap(mPos, bufferLength);
+      int pos = int(offset);
+      if (pos >= bufferLength)
+         pos = 0;
+      int posNext = pos + 1;
+      if (posNext >= bufferLength)
+         posNext = 0;
+      float a = float(offset - pos);
+
+      const float* channel0 = buffer->GetChannel(0);
+      float sample0 = channel0[pos] + a * (channel0[posNext] - channel0[pos]);
+      int numChannels = buffer->NumActiveChannels();
+      if (numChannels == 1)
       {
-         float sample = GetInterpolatedSample(mPos, buffer, bufferLength, std::clamp(ch + mStereoPosition, 0.f, 1.f));
-         output[ch] += sample * window * mVol * (1 + (ch == 0 ? mStereoPosition : -mStereoPosition));
+         output[0] += sample0 * gain * (1 + mStereoPosition);
+      }
+      else
+      {
+         //channel blends are clamped to [0,1], so only the first two channels are ever read
+         const float* channel1 = buffer->GetChannel(1);
+         float sample1 = channel1[pos] + a * (channel1[posNext] - channel1[pos]);
+         for (int ch = 0; ch < numChannels; ++ch)
+         {
+            float channelBlend = std::clamp(ch + mStereoPosition, 0.f, 1.f);
+            float sample = sample0 + channelBlend * (sample1 - sample0);
+            output[ch] += sample * gain * (1 + (ch == 0 ? mStereoPosition : -mStereoPosition));
+         }
       }
    }
+
+   return true;
 }
 
 void Grain::DrawGrain(int idx, float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength, float gain, const Granulator* granulator) const
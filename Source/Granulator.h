@@ -29,7 +29,8 @@
 #include "ChannelBuffer.h"
 #include "readerwriterqueue.h"
 
-#define MAX_GRAINS 32
+#define MAX_GRAINS 256
+#define DENSE_GRAIN_OVERLAP 32 //volume compensation and pressure control are scaled to this. the overlap sliders go up to MAX_GRAINS.
 
 class Granulator;
 
@@ -46,7 +47,7 @@ class Grain
 {
 public:
    void Spawn(double time, double pos, float speedMult, float lengthInMs, float vol, float width);
-   void Process(double time, ChannelBuffer* buffer, int bufferLength, float* output, const Granulator* granulator);
+   bool Process(double time, ChannelBuffer* buffer, int bufferLength, float* output, const Granulator* granulator);
    void DrawGrain(int idx, float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength, float gain, const Granulator* granulator) const;
    void Clear() { mVol = 0; }
 
@@ -73,6 +74,7 @@ public:
    void SetLiveMode(bool live) { mLiveMode = live; }
    void QueueGrainSpawn(double spawnTime);
    static inline double GetWindow(GrainWindowType type, double shape, double grainLengthMs, double phase);
+   static inline float GetWindowFast(GrainWindowType type, float shape, float grainLengthMs, float phase);
 
    bool mSpawnGrains{ true };
    float mSpeed{ 1 };
@@ -93,6 +95,9 @@ private:
    double mNextGrainSpawnMs{ 0 };
    int mNextGrainIdx{ 0 };
    Grain mGrains[MAX_GRAINS]{};
+   int mActiveGrains[MAX_GRAINS]{}; //indices into mGrains, so we only process grains that are sounding
+   int mNumActiveGrains{ 0 };
+   bool mGrainIsActive[MAX_GRAINS]{};
    bool mLiveMode{ false };
    BiquadFilter mBiquad[ChannelBuffer::kMaxNumChannels]{};
    moodycamel::ReaderWriterQueue<double> mQueuedGrainSpawnTimes;
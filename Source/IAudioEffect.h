@@ -35,6 +35,8 @@ public:
    virtual void ProcessAudio(double time, ChannelBuffer* buffer) = 0;
    void SetEnabled(bool enabled) override = 0;
    virtual float GetEffectAmount() { return 0; }
+   virtual float GetTailLengthMs() { return 0; } //how long we keep sounding after our input goes silent, or -1 if we can make sound on our own
+   virtual int GetLatencySamples() { return 0; } //how late our output is relative to our input
    virtual std::string GetType() = 0;
    bool CanMinimize() override { return false; }
    bool IsSaveable() override { return false; }
@@ -37,3 +37,24 @@ void IAudioProcessor::SyncBuffers(int overrideNumOutputChannels)
 
    SyncOutputBuffer(numOutputChannels);
 }
+
+//adds our input buffer, which has been processed in place, into target's buffer, then resets ours for the next block.
+//if we're target's only input and nothing has been written to it yet, we just trade sample storage with it instead.
+void IAudioProcessor::SendBufferToTarget(IAudioReceiver* target)
+{
+   ChannelBuffer* buffer = GetBuffer();
+   if (target != nullptr)
+   {
+      ChannelBuffer* out = target->GetBuffer();
+      if (target == GetSoleTarget() && out->IsCleared() && out->NumActiveChannels() == buffer->NumActiveChannels() && buffer->CanSwapChannelData(out))
+      {
+         buffer->SwapChannelData(out);
+      }
+      else
+      {
+         for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+            Add(out->GetChannel(ch), buffer->GetChannel(ch), buffer->BufferSize());
+      }
+   }
+   buffer->Reset();
+}
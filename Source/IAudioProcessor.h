@@ -39,4 +39,5 @@ public:
 
 protected:
    void SyncBuffers(int overrideNumOutputChannels = -1);
+   void SendBufferToTarget(IAudioReceiver* target);
 };
@@ -36,6 +36,47 @@ IAudioReceiver* IAudioSource::GetTarget(int index)
    return nullptr;
 }
 
+namespace
+{
+   const float kSilenceThreshold = .000001f; //-120dB
+   const double kSleepMarginMs = 250; //extra time before sleeping, for things like filter ringing that aren't worth declaring as tails
+}
+
+//called before Process() each block. returns true if we can skip processing, because our input has been silent for longer than our tail.
+//we wake up as soon as anything is written to our input.
+bool IAudioSource::UpdateSleep()
+{
+   mSleeping = false;
+
+   float tailMs = GetTailLengthMs();
+   if (tailMs < 0)
+   {
+      mSilentInputMs = 0;
+      return false;
+   }
+
+   IAudioReceiver* receiver = dynamic_cast<IAudioReceiver*>(this);
+   if (receiver == nullptr)
+      return false;
+
+   ChannelBuffer* input = receiver->GetBuffer();
+   if (!input->IsSilent(kSilenceThreshold))
+   {
+      mSilentInputMs = 0;
+      return false;
+   }
+
+   if (mSilentInputMs <= tailMs + kSleepMarginMs)
+   {
+      mSilentInputMs += gBufferSizeMs;
+      return false;
+   }
+
+   input->Reset(); //drop anything below the threshold, since we won't be processing it
+   mSleeping = true;
+   return true;
+}
+
 void IAudioSource::SyncOutputBuffer(int numChannels)
 {
    for (int i = 0; i < GetNumTargets(); ++i)
@@ -38,16 +38,27 @@ class IAudioSource : public virtual IPatchable
 public:
    IAudioSource()
    : mVizBuffer(VIZ_BUFFER_SECONDS * gSampleRate)
-   {}
+   {
+      mVizBuffer.SetWriteOnlyWhenViewed(true);
+   }
    virtual ~IAudioSource() {}
    virtual void Process(double time) = 0;
    IAudioReceiver* GetTarget(int index = 0);
    virtual int GetNumTargets() { return 1; }
+   virtual int GetLatencySamples() { return 0; } //how late this source's output is relative to its input, for delay compensation. call ArrangeAudioSourceDependencies() when it changes.
+   virtual float GetTailLengthMs() { return -1; } //how long our output can keep going after our input falls silent, or -1 if we can make sound by ourselves
+   bool UpdateSleep();
+   bool IsSleeping() const { return mSleeping; }
    RollingBuffer* GetVizBuffer() { return &mVizBuffer; }
+   void SetSoleTarget(IAudioReceiver* target) { mSoleTarget = target; } //set by ArrangeAudioSourceDependencies() when we're the only audio input to that receiver
 
 protected:
    void SyncOutputBuffer(int numChannels);
+   IAudioReceiver* GetSoleTarget() const { return mSoleTarget; }
 
 private:
    RollingBuffer mVizBuffer;
+   IAudioReceiver* mSoleTarget{ nullptr };
+   double mSilentInputMs{ 0 };
+   bool mSleeping{ false };
 };
@@ -208,9 +208,10 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
    if (IsEnabled())
    {
       IAudioSource* audioSource = dynamic_cast<IAudioSource*>(this);
-      if (audioSource)
+      if (audioSource && UserPrefs.draw_module_highlights.Get())
       {
          RollingBuffer* vizBuff = audioSource->GetVizBuffer();
+         vizBuff->MarkViewed(50); //only needs a rough level
          int numSamples = std::min(500, vizBuff->Size());
          float sample;
          float mag = 0;
@@ -228,8 +229,7 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
          mag *= 3;
          mag = ofClamp(mag, 0, 1);
 
-         if (UserPrefs.draw_module_highlights.Get())
-            highlight = mag * .15f;
+         highlight = mag * .15f;
       }
 
       if (GetPatchCableSource() != nullptr)
@@ -0,0 +1,52 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    IMidiVoice.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "IMidiVoice.h"
+#include "Scale.h"
+
+void IMidiVoice::UpdateModulationBlocks()
+{
+   mPitchBendBlock = ModulationParameters::GetBlock(mModulators.pitchBend, ModulationParameters::kDefaultPitchBend);
+   mModWheelBlock = ModulationParameters::GetBlock(mModulators.modWheel, ModulationParameters::kDefaultModWheel);
+   mPressureBlock = ModulationParameters::GetBlock(mModulators.pressure, ModulationParameters::kDefaultPressure);
+
+   if (mFreqs.empty())
+      mFreqs.resize(gBufferSize);
+
+   if (mPitchBendBlock.IsConstant())
+   {
+      mFreqs[0] = TheScale->PitchToFreq(GetPitch(0));
+      mFreqBlock = ModulationBlock{ mFreqs.data(), 0 };
+   }
+   else
+   {
+      for (int i = 0; i < gBufferSize; ++i)
+         mFreqs[i] = GetPitch(i);
+      TheScale->PitchToFreq(mFreqs.data(), mFreqs.data(), gBufferSize);
+      mFreqBlock = ModulationBlock{ mFreqs.data(), ~0 };
+   }
+}
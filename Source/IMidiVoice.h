@@ -53,12 +53,21 @@ public:
       return mPan;
    }
 
-   float GetPitch(int samplesIn) { return mPitch + (mModulators.pitchBend ? mModulators.pitchBend->GetValue(samplesIn) : ModulationParameters::kDefaultPitchBend); }
-   float GetModWheel(int samplesIn) { return mModulators.modWheel ? mModulators.modWheel->GetValue(samplesIn) : ModulationParameters::kDefaultModWheel; }
-   float GetPressure(int samplesIn) { return mModulators.pressure ? mModulators.pressure->GetValue(samplesIn) : ModulationParameters::kDefaultPressure; }
+   //call before Process(), so the per-sample getters below are just array reads
+   void UpdateModulationBlocks();
+
+   float GetPitch(int samplesIn) const { return mPitch + mPitchBendBlock[samplesIn]; }
+   float GetFreq(int samplesIn) const { return mFreqBlock[samplesIn]; } //TheScale->PitchToFreq(GetPitch(samplesIn))
+   float GetModWheel(int samplesIn) const { return mModWheelBlock[samplesIn]; }
+   float GetPressure(int samplesIn) const { return mPressureBlock[samplesIn]; }
 
 private:
    float mPitch{ 0 };
    float mPan{ 0 };
    ModulationParameters mModulators;
+   ModulationBlock mPitchBendBlock{ &ModulationParameters::kDefaultPitchBend, 0 };
+   ModulationBlock mModWheelBlock{ &ModulationParameters::kDefaultModWheel, 0 };
+   ModulationBlock mPressureBlock{ &ModulationParameters::kDefaultPressure, 0 };
+   std::vector<float> mFreqs;
+   ModulationBlock mFreqBlock;
 };
@@ -50,6 +50,7 @@ public:
 
    void PlayNoteInternal(NoteMessage note, bool isFromMainThreadAndScheduled);
 
+   INoteSource* GetNoteSource() const { return mNoteSource; }
    void ResetStackDepth() { mStackDepth = 0; }
    bool* GetNotes() { return mNotes; }
    bool HasHeldNotes();
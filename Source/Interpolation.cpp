@@ -0,0 +1,316 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    Interpolation.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "Interpolation.h"
+
+#include "juce_audio_basics/juce_audio_basics.h"
+
+namespace
+{
+   const int kMaxTaps = 8;
+   const int kSincTapsBefore = 3;
+   const int kSincPhases = 256;
+
+   //polyphase table for an 8-point blackman-windowed sinc, one row of tap weights per fractional position
+   struct SincTable
+   {
+      SincTable()
+      {
+         for (int p = 0; p <= kSincPhases; ++p)
+         {
+            double frac = double(p) / kSincPhases;
+            double sum = 0;
+            for (int k = 0; k < kMaxTaps; ++k)
+            {
+               double x = (k - kSincTapsBefore) - frac;
+               double weight;
+               if (x == 0)
+                  weight = 1;
+               else if (x == floor(x))
+                  weight = 0; //exactly zero on the other integer taps, so unity-rate reads reduce to a copy
+               else
+                  weight = sin(PI * x) / (PI * x) * (.42 + .5 * cos(PI * x / 4) + .08 * cos(TWO_PI * x / 4));
+               mWeights[p][k] = (float)weight;
+               sum += weight;
+            }
+            for (int k = 0; k < kMaxTaps; ++k)
+               mWeights[p][k] = float(mWeights[p][k] / sum); //unity gain at dc
+         }
+      }
+
+      float mWeights[kSincPhases + 1][kMaxTaps]{};
+   };
+
+   const SincTable& GetSincTable()
+   {
+      static const SincTable sTable;
+      return sTable;
+   }
+
+   const SincTable& sSincTableInit = GetSincTable(); //build at startup rather than on the audio thread
+
+   int NumTaps(InterpolationQuality quality)
+   {
+      return Interpolation::TapsBefore(quality) + 1 + Interpolation::TapsAfter(quality);
+   }
+
+   //weights for the taps starting TapsBefore() samples before the integer read position
+   inline void GetWeights(InterpolationQuality quality, float frac, float* weights)
+   {
+      switch (quality)
+      {
+         case InterpolationQuality::Linear:
+            weights[0] = 1 - frac;
+            weights[1] = frac;
+            break;
+         case InterpolationQuality::Hermite:
+         {
+            float frac2 = frac * frac;
+            float frac3 = frac2 * frac;
+            weights[0] = -.5f * frac3 + frac2 - .5f * frac;
+            weights[1] = 1.5f * frac3 - 2.5f * frac2 + 1;
+            weights[2] = -1.5f * frac3 + 2 * frac2 + .5f * frac;
+            weights[3] = .5f * frac3 - .5f * frac2;
+            break;
+         }
+         case InterpolationQuality::Sinc:
+         {
+            float phase = frac * kSincPhases;
+            int p = std::min(int(phase), kSincPhases - 1);
+            float a = phase - p;
+            const float* row0 = GetSincTable().mWeights[p];
+            const float* row1 = GetSincTable().mWeights[p + 1];
+            for (int k = 0; k < kMaxTaps; ++k)
+               weights[k] = row0[k] + a * (row1[k] - row0[k]);
+            break;
+         }
+      }
+   }
+
+   inline float ApplyWeights(const float* taps, const float* weights, int numTaps)
+   {
+      float output = 0;
+      for (int k = 0; k < numTaps; ++k)
+         output += taps[k] * weights[k];
+      return output;
+   }
+
+   inline void AddScaled(float* dst, const float* src, float scale, int numSamples)
+   {
+#ifdef USE_VECTOR_OPS
+      juce::FloatVectorOperations::addWithMultiply(dst, src, scale, numSamples);
+#else
+      for (int i = 0; i < numSamples; ++i)
+         dst[i] += src[i] * scale;
+#endif
+   }
+
+   inline void CopyScaled(float* dst, const float* src, float scale, int numSamples)
+   {
+#ifdef USE_VECTOR_OPS
+      juce::FloatVectorOperations::copyWithMultiply(dst, src, scale, numSamples);
+#else
+      for (int i = 0; i < numSamples; ++i)
+         dst[i] = src[i] * scale;
+#endif
+   }
+
+   //one read where the kernel hangs off an end of the buffer, so the taps need wrapping (or clamping, if it isn't a loop)
+   inline float ReadAtEdge(int readPos, float frac, const float* buffer, int bufferSize, InterpolationQuality quality, bool wrap)
+   {
+      float taps[kMaxTaps];
+      float weights[kMaxTaps];
+      int numTaps = NumTaps(quality);
+      int first = readPos - Interpolation::TapsBefore(quality);
+      for (int k = 0; k < numTaps; ++k)
+      {
+         int index;
+         if (wrap)
+         {
+            index = (first + k) % bufferSize;
+            if (index < 0)
+               index += bufferSize;
+         }
+         else
+         {
+            index = std::clamp(first + k, 0, bufferSize - 1);
+         }
+         taps[k] = buffer[index];
+      }
+      GetWeights(quality, frac, weights);
+      return ApplyWeights(taps, weights, numTaps);
+   }
+}
+
+int Interpolation::TapsBefore(InterpolationQuality quality)
+{
+   switch (quality)
+   {
+      case InterpolationQuality::Linear: return 0;
+      case InterpolationQuality::Hermite: return 1;
+      case InterpolationQuality::Sinc: return kSincTapsBefore;
+   }
+   return 0;
+}
+
+int Interpolation::TapsAfter(InterpolationQuality quality)
+{
+   switch (quality)
+   {
+      case InterpolationQuality::Linear: return 1;
+      case InterpolationQuality::Hermite: return 2;
+      case InterpolationQuality::Sinc: return kMaxTaps - kSincTapsBefore - 1;
+   }
+   return 1;
+}
+
+float Interpolation::Read(double offset, const float* buffer, int bufferSize, InterpolationQuality quality)
+{
+   if (quality == InterpolationQuality::Linear)
+      return GetInterpolatedSample(offset, buffer, bufferSize);
+
+   offset = DoubleWrap(offset, bufferSize);
+   int pos = int(offset);
+   float frac = float(offset - pos);
+   int first = pos - TapsBefore(quality);
+   if (first >= 0 && pos + TapsAfter(quality) < bufferSize)
+   {
+      float weights[kMaxTaps];
+      GetWeights(quality, frac, weights);
+      return ApplyWeights(buffer + first, weights, NumTaps(quality));
+   }
+   return ReadAtEdge(pos, frac, buffer, bufferSize, quality, true);
+}
+
+namespace
+{
+   double ReadBlockImpl(double offset, double increment, const float* buffer, int bufferSize, float* output, int numSamples, InterpolationQuality quality, float gain, bool accumulate, bool wrap)
+   {
+      if (bufferSize <= 0)
+      {
+         if (!accumulate)
+            ::Clear(output, numSamples);
+         return offset + increment * numSamples;
+      }
+
+      const int tapsBefore = Interpolation::TapsBefore(quality);
+      const int tapsAfter = Interpolation::TapsAfter(quality);
+      const int numTaps = NumTaps(quality);
+      float weights[kMaxTaps];
+
+      double pos = wrap ? DoubleWrap(offset, bufferSize) : offset;
+      int i = 0;
+      while (i < numSamples)
+      {
+         int readPos = (int)floor(pos); //unwrapped (clamped) positions can be negative
+         int remaining = numSamples - i;
+         int run;
+
+         if (readPos - tapsBefore >= 0 && readPos + tapsAfter < bufferSize)
+         {
+            //figure out how many reads we can do before the kernel would need to wrap, then do them without any wrapping checks
+            if (increment > 0)
+               run = int((bufferSize - 1 - tapsAfter - pos) / increment) + 1;
+            else if (increment < 0)
+               run = int((pos - tapsBefore) / -increment) + 1;
+            else
+               run = remaining;
+            run = std::clamp(run, 1, remaining);
+
+            float* dst = output + i;
+            float frac = float(pos - readPos);
+            if (increment == 1 && run > 1)
+            {
+               //fixed fractional position, so this is a short fir over contiguous input
+               GetWeights(quality, frac, weights);
+               const float* src = buffer + readPos - tapsBefore;
+               bool wrote = accumulate;
+               for (int k = 0; k < numTaps; ++k)
+               {
+                  if (weights[k] == 0)
+                     continue;
+                  if (wrote)
+                     AddScaled(dst, src + k, weights[k] * gain, run);
+                  else
+                     CopyScaled(dst, src + k, weights[k] * gain, run);
+                  wrote = true;
+               }
+               if (!wrote)
+                  ::Clear(dst, run);
+               pos += run;
+            }
+            else
+            {
+               for (int j = 0; j < run; ++j)
+               {
+                  readPos = int(pos);
+                  GetWeights(quality, float(pos - readPos), weights);
+                  float sample = ApplyWeights(buffer + readPos - tapsBefore, weights, numTaps) * gain;
+                  if (accumulate)
+                     dst[j] += sample;
+                  else
+                     dst[j] = sample;
+                  pos += increment;
+               }
+            }
+         }
+         else
+         {
+            run = 1;
+            float sample = ReadAtEdge(readPos, float(pos - readPos), buffer, bufferSize, quality, wrap) * gain;
+            if (accumulate)
+               output[i] += sample;
+            else
+               output[i] = sample;
+            pos += increment;
+         }
+
+         i += run;
+         if (wrap && (pos >= bufferSize || pos < 0))
+            pos = DoubleWrap(pos, bufferSize);
+      }
+
+      return offset + increment * numSamples;
+   }
+}
+
+double Interpolation::ReadBlock(double offset, double increment, const float* buffer, int bufferSize, float* output, int numSamples, InterpolationQuality quality, float gain /*= 1*/, bool accumulate /*= false*/)
+{
+   return ReadBlockImpl(offset, increment, buffer, bufferSize, output, numSamples, quality, gain, accumulate, true);
+}
+
+double Interpolation::ReadBlockClamped(double offset, double increment, const float* buffer, int bufferSize, float* output, int numSamples, InterpolationQuality quality, float gain /*= 1*/, bool accumulate /*= false*/)
+{
+   return ReadBlockImpl(offset, increment, buffer, bufferSize, output, numSamples, quality, gain, accumulate, false);
+}
+
+void Interpolation::FillEnumMap(EnumMap& map)
+{
+   map["linear"] = (int)InterpolationQuality::Linear;
+   map["hermite"] = (int)InterpolationQuality::Hermite;
+   map["sinc"] = (int)InterpolationQuality::Sinc;
+}
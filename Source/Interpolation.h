@@ -0,0 +1,55 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    Interpolation.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SynthGlobals.h"
+
+enum class InterpolationQuality
+{
+   Linear,
+   Hermite, //4-point, 3rd-order
+   Sinc //8-point windowed sinc
+};
+
+namespace Interpolation
+{
+   //reads a single sample at a fractional position. positions wrap around bufferSize, like GetInterpolatedSample().
+   float Read(double offset, const float* buffer, int bufferSize, InterpolationQuality quality);
+
+   //reads numSamples, starting at offset and stepping by increment. positions wrap around bufferSize.
+   //output is overwritten, or added to if accumulate is set. returns the unwrapped offset after the last read.
+   double ReadBlock(double offset, double increment, const float* buffer, int bufferSize, float* output, int numSamples, InterpolationQuality quality, float gain = 1, bool accumulate = false);
+   //the same, for a buffer that isn't a loop: taps off either end repeat the edge sample instead of wrapping around
+   double ReadBlockClamped(double offset, double increment, const float* buffer, int bufferSize, float* output, int numSamples, InterpolationQuality quality, float gain = 1, bool accumulate = false);
+
+   //how many samples before/after the integer read position a kernel touches
+   int TapsBefore(InterpolationQuality quality);
+   int TapsAfter(InterpolationQuality quality);
+
+   void FillEnumMap(EnumMap& map);
+}
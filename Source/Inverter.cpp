@@ -53,17 +53,15 @@ void Inverter::Process(double time)
 
    if (target)
    {
-      ChannelBuffer* out = target->GetBuffer();
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
       {
          if (mEnabled)
-            Mult(GetBuffer()->GetChannel(ch), -1, out->BufferSize());
-         Add(out->GetChannel(ch), GetBuffer()->GetChannel(ch), out->BufferSize());
+            Mult(GetBuffer()->GetChannel(ch), -1, GetBuffer()->BufferSize());
          GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
       }
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void Inverter::DrawModule()
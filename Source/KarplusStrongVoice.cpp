@@ -67,21 +67,10 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
    if (IsDone(time))
       return false;
 
-   int bufferSize = out->BufferSize();
+   int bufferSize = out->BufferSize(); //already oversampled, PolyphonyMgr filters it back down
    int channels = out->NumActiveChannels();
-   double sampleIncrementMs = gInvSampleRateMs;
-   double sampleRate = gSampleRate;
-   ChannelBuffer* destBuffer = out;
-
-   if (oversampling != 1)
-   {
-      gMidiVoiceWorkChannelBuffer.SetNumActiveChannels(channels);
-      destBuffer = &gMidiVoiceWorkChannelBuffer;
-      gMidiVoiceWorkChannelBuffer.Clear();
-      bufferSize *= oversampling;
-      sampleIncrementMs /= oversampling;
-      sampleRate *= oversampling;
-   }
+   double sampleIncrementMs = gInvSampleRateMs / oversampling;
+   double sampleRate = gSampleRate * oversampling;
 
    float freq;
    float filterRate;
@@ -92,18 +81,23 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
    if (mVoiceParams->mLiteCPUMode)
       DoParameterUpdate(0, oversampling, pitch, freq, filterRate, filterLerp, oscPhaseInc);
 
+   ::ADSR::Renderer oscEnv(*mOsc.GetADSR(), time, sampleIncrementMs);
+   ::ADSR::Renderer env(mEnv, time, sampleIncrementMs);
+
    for (int pos = 0; pos < bufferSize; ++pos)
    {
       if (!mVoiceParams->mLiteCPUMode)
          DoParameterUpdate(pos / oversampling, oversampling, pitch, freq, filterRate, filterLerp, oscPhaseInc);
 
+      float envValue = env.Next();
+
       if (mVoiceParams->mSourceType == kSourceTypeSaw)
          mOsc.SetType(kOsc_Saw);
       else
          mOsc.SetType(kOsc_Sin);
       mOscPhase += oscPhaseInc;
       float sample = 0;
-      float oscSample = mOsc.Audio(time, mOscPhase);
+      float oscSample = mOsc.mOsc.Value(mOscPhase) * oscEnv.Next();
       float noiseSample = RandomSample();
       float pitchBlend = ofClamp((pitch - 40) / 60.0f, 0, 1);
       pitchBlend *= pitchBlend;
@@ -117,7 +111,7 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
          sample = mKarplusStrongModule->GetBuffer()->GetChannel(0)[pos / oversampling];
 
       if (mVoiceParams->mSourceType != kSourceTypeInputNoEnvelope)
-         sample *= mEnv.Value(time) + mVoiceParams->mExcitation;
+         sample *= envValue + mVoiceParams->mExcitation;
 
       float samplesAgo = sampleRate / freq;
       AssertIfDenormal(samplesAgo);
@@ -139,7 +133,7 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
       mFilteredSample = ofLerp(feedbackSample, mFilteredSample, filterLerp);
       JUCE_UNDENORMALISE(mFilteredSample);
       //sample += mFeedbackRamp.Value(time) * mFilterSample;
-      float feedback = mFilteredSample * sqrtf(mVoiceParams->mFeedback + GetPressure(pos) * .02f) * mMuteRamp.Value(time);
+      float feedback = mFilteredSample * sqrtf(mVoiceParams->mFeedback + GetPressure(pos / oversampling) * .02f) * mMuteRamp.Value(time);
       if (mVoiceParams->mInvert)
          feedback *= -1;
 
@@ -155,35 +149,17 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
 
       if (channels == 1)
       {
-         destBuffer->GetChannel(0)[pos] += outputSample;
+         out->GetChannel(0)[pos] += outputSample;
       }
       else
       {
-         destBuffer->GetChannel(0)[pos] += outputSample * GetLeftPanGain(GetPan());
-         destBuffer->GetChannel(1)[pos] += outputSample * GetRightPanGain(GetPan());
+         out->GetChannel(0)[pos] += outputSample * GetLeftPanGain(GetPan());
+         out->GetChannel(1)[pos] += outputSample * GetRightPanGain(GetPan());
       }
 
       time += sampleIncrementMs;
    }
 
-   if (oversampling != 1)
-   {
-      //assume power-of-two
-      while (oversampling > 1)
-      {
-         for (int i = 0; i < bufferSize; ++i)
-         {
-            for (int ch = 0; ch < channels; ++ch)
-               destBuffer->GetChannel(ch)[i] = (destBuffer->GetChannel(ch)[i * 2] + destBuffer->GetChannel(ch)[i * 2 + 1]) / 2;
-         }
-         oversampling /= 2;
-         bufferSize /= 2;
-      }
-
-      for (int ch = 0; ch < channels; ++ch)
-         Add(out->GetChannel(ch), destBuffer->GetChannel(ch), bufferSize);
-   }
-
    return true;
 }
 
@@ -200,9 +176,14 @@ void KarplusStrongVoice::DoParameterUpdate(int samplesIn,
 
    pitch = GetPitch(samplesIn);
    if (mVoiceParams->mInvert)
+   {
       pitch += 12; //inverting the pitch gives an octave down sound by halving the resonating frequency, so correct for that
-
-   freq = TheScale->PitchToFreq(pitch);
+      freq = TheScale->PitchToFreq(pitch);
+   }
+   else
+   {
+      freq = GetFreq(samplesIn);
+   }
    filterRate = mVoiceParams->mFilter * pow(freq / 300, exp2(mVoiceParams->mPitchTone)) * (1 + GetModWheel(samplesIn));
    filterLerp = ofClamp(exp2(-filterRate / oversampling), 0, 1);
 
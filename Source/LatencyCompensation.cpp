@@ -0,0 +1,166 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    LatencyCompensation.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "LatencyCompensation.h"
+#include "IAudioSource.h"
+#include "IAudioReceiver.h"
+
+#include <map>
+
+namespace
+{
+   const float kMaxCompensationSeconds = 2;
+}
+
+void LatencyCompensation::Update(const std::vector<IAudioSource*>& sources)
+{
+   //latency at each source's output, and the worst latency arriving at each receiver
+   std::map<IAudioSource*, int> outputLatency;
+   std::map<IAudioReceiver*, int> inputLatency;
+   for (auto* source : sources)
+   {
+      int latency = source->GetLatencySamples();
+      auto input = inputLatency.find(dynamic_cast<IAudioReceiver*>(source));
+      if (input != inputLatency.end())
+         latency += input->second;
+      outputLatency[source] = latency;
+
+      for (int i = 0; i < source->GetNumTargets(); ++i)
+      {
+         IAudioReceiver* target = source->GetTarget(i);
+         if (target != nullptr)
+            inputLatency[target] = std::max(inputLatency[target], latency);
+      }
+   }
+
+   std::vector<DelayedOutput> outputs;
+   for (auto* source : sources)
+   {
+      for (int i = 0; i < source->GetNumTargets(); ++i)
+      {
+         IAudioReceiver* target = source->GetTarget(i);
+         if (target == nullptr)
+            continue;
+         int delay = std::min(inputLatency[target] - outputLatency[source], int(kMaxCompensationSeconds * gSampleRate));
+         if (delay <= 0)
+            continue;
+
+         bool alreadyAdded = false;
+         for (const auto& output : outputs)
+         {
+            if (output.mSource == source && output.mTarget == target)
+               alreadyAdded = true;
+         }
+         if (alreadyAdded)
+            continue;
+
+         DelayedOutput output;
+         output.mSource = source;
+         output.mTarget = target;
+         output.mDelaySamples = delay;
+
+         //keep whatever is already in flight on connections that didn't change
+         for (auto& oldOutput : mOutputs)
+         {
+            if (oldOutput.mSource == source && oldOutput.mTarget == target && oldOutput.mDelaySamples == delay)
+            {
+               output.mDelayPos = oldOutput.mDelayPos;
+               output.mDelayLine.swap(oldOutput.mDelayLine);
+               break;
+            }
+         }
+
+         output.mDelayLine.resize(ChannelBuffer::kMaxNumChannels * delay);
+         output.mSnapshot.resize(ChannelBuffer::kMaxNumChannels * gBufferSize);
+         outputs.push_back(std::move(output));
+      }
+   }
+
+   mOutputs.swap(outputs);
+}
+
+void LatencyCompensation::PreProcess(IAudioSource* source)
+{
+   for (auto& output : mOutputs)
+   {
+      if (output.mSource != source)
+         continue;
+
+      ChannelBuffer* buffer = output.mTarget->GetBuffer();
+      int bufferSize = buffer->BufferSize();
+      if (bufferSize > gBufferSize)
+         continue;
+      output.mSnapshotChannels = buffer->NumActiveChannels();
+      for (int ch = 0; ch < output.mSnapshotChannels; ++ch)
+         BufferCopy(&output.mSnapshot[ch * bufferSize], buffer->GetChannel(ch), bufferSize);
+   }
+}
+
+void LatencyCompensation::PostProcess(IAudioSource* source)
+{
+   for (auto& output : mOutputs)
+   {
+      if (output.mSource != source)
+         continue;
+
+      ChannelBuffer* buffer = output.mTarget->GetBuffer();
+      int bufferSize = buffer->BufferSize();
+      if (bufferSize > gBufferSize)
+         continue;
+
+      //whatever the source just added to the target is its contribution. swap that for the contribution from mDelaySamples ago.
+      for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+      {
+         float* delayLine = &output.mDelayLine[ch * output.mDelaySamples];
+         int pos = output.mDelayPos;
+         if (ch < buffer->NumActiveChannels())
+         {
+            float* data = buffer->GetChannel(ch);
+            const float* before = ch < output.mSnapshotChannels ? &output.mSnapshot[ch * bufferSize] : nullptr;
+            for (int i = 0; i < bufferSize; ++i)
+            {
+               float prior = before ? before[i] : 0;
+               float delayed = delayLine[pos];
+               delayLine[pos] = data[i] - prior;
+               data[i] = prior + delayed;
+               if (++pos == output.mDelaySamples)
+                  pos = 0;
+            }
+         }
+         else
+         {
+            for (int i = 0; i < bufferSize; ++i)
+            {
+               delayLine[pos] = 0;
+               if (++pos == output.mDelaySamples)
+                  pos = 0;
+            }
+         }
+      }
+      output.mDelayPos = (output.mDelayPos + bufferSize) % output.mDelaySamples;
+   }
+}
@@ -0,0 +1,63 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    LatencyCompensation.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ChannelBuffer.h"
+
+#include <vector>
+
+class IAudioSource;
+class IAudioReceiver;
+
+//automatic plugin delay compensation. when paths with different amounts of reported latency (see IAudioSource::GetLatencySamples()) merge into the
+//same receiver, the outputs feeding that receiver through the faster paths get delayed to line up with the slowest one.
+class LatencyCompensation
+{
+public:
+   //recalculates path latencies from sources, which must already be in processing order. call with the audio thread locked.
+   void Update(const std::vector<IAudioSource*>& sources);
+   void Clear() { mOutputs.clear(); }
+
+   //wrap each source's Process() with these
+   void PreProcess(IAudioSource* source);
+   void PostProcess(IAudioSource* source);
+
+private:
+   struct DelayedOutput
+   {
+      IAudioSource* mSource{ nullptr };
+      IAudioReceiver* mTarget{ nullptr };
+      int mDelaySamples{ 0 };
+      int mDelayPos{ 0 };
+      int mSnapshotChannels{ 0 };
+      std::vector<float> mDelayLine;
+      std::vector<float> mSnapshot;
+   };
+
+   std::vector<DelayedOutput> mOutputs;
+};
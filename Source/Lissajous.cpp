@@ -57,10 +57,7 @@ void Lissajous::Process(double time)
    if (target)
    {
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-      {
-         Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), bufferSize);
          GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
-      }
    }
 
    if (mEnabled)
@@ -75,7 +72,7 @@ void Lissajous::Process(double time)
       mOffset %= NUM_LISSAJOUS_POINTS;
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void Lissajous::DrawModule()
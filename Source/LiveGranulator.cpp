@@ -56,6 +56,7 @@ void LiveGranulator::CreateUIControls()
    IDrawableModule::CreateUIControls();
    UIBLOCK(80);
    FLOATSLIDER(mGranOverlap, "overlap", &mGranulator.mGrainOverlap, .5f, MAX_GRAINS);
+   mGranOverlap->SetMode(FloatSlider::kSquare); //the range goes up to hundreds of grains, but most of the useful settings are low
    FLOATSLIDER(mGranSpeed, "speed", &mGranulator.mSpeed, -3, 3);
    FLOATSLIDER(mGranLengthMs, "len ms", &mGranulator.mGrainLengthMs, 1, 1000);
    FLOATSLIDER(mDrySlider, "dry", &mDry, 0, 1);
@@ -134,7 +135,7 @@ void LiveGranulator::ProcessAudio(double time, ChannelBuffer* buffer)
          float sample[ChannelBuffer::kMaxNumChannels];
          Clear(sample, ChannelBuffer::kMaxNumChannels);
          mGranulator.ProcessFrame(time, mBuffer.GetRawBuffer(), mBufferLength, mBuffer.GetRawBufferOffset(0) - mFreezeExtraSamples - 1 - gBufferSize + mPos, 1.0f, sample);
-         float grainProportion = std::clamp((mGranulator.mGrainOverlap - 1) / (MAX_GRAINS - 1), 0.0f, 1.0f);
+         float grainProportion = std::clamp((mGranulator.mGrainOverlap - 1) / (DENSE_GRAIN_OVERLAP - 1), 0.0f, 1.0f);
          float gainScale = ofLerp(.333f, 1.0f, (1 - grainProportion) * (1 - grainProportion) * (1 - grainProportion));
          for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
             buffer->GetChannel(ch)[i] = mDry * buffer->GetChannel(ch)[i] + sample[ch] * gainScale;
@@ -183,6 +184,15 @@ float LiveGranulator::GetEffectAmount()
    return ofClamp(.5f + fabsf(mGranulator.mSpeed - 1), 0, 1);
 }
 
+float LiveGranulator::GetTailLengthMs()
+{
+   if (!mEnabled)
+      return 0;
+   if (mFreeze)
+      return -1;
+   return mBufferLength / gSampleRate * 1000; //grains can still be reading anywhere in the buffer
+}
+
 void LiveGranulator::Freeze()
 {
    mFreeze = true;
@@ -52,6 +52,7 @@ public:
    void ProcessAudio(double time, ChannelBuffer* buffer) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
+   float GetTailLengthMs() override;
    std::string GetType() override { return "granulator"; }
 
    void OnTimeEvent(double time) override;
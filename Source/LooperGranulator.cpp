@@ -48,6 +48,7 @@ void LooperGranulator::CreateUIControls()
    UIBLOCK(3, 3, 120);
    CHECKBOX(mOnCheckbox, "on", &mOn);
    FLOATSLIDER(mGranOverlap, "overlap", &mGranulator.mGrainOverlap, .5f, MAX_GRAINS);
+   mGranOverlap->SetMode(FloatSlider::kSquare); //the range goes up to hundreds of grains, but most of the useful settings are low
    FLOATSLIDER(mGranSpeed, "speed", &mGranulator.mSpeed, -3, 3);
    FLOATSLIDER(mGranLengthMs, "len ms", &mGranulator.mGrainLengthMs, 1, 1000);
    FLOATSLIDER(mPosSlider, "loop pos", &mDummyPos, 0, 1);
@@ -11,6 +11,7 @@
 #include "juce_gui_basics/juce_gui_basics.h"
 #include <memory>
 #include "VSTScanner.h"
+#include "PluginSandbox.h"
 #include "SynthGlobals.h"
 
 #include "VersionInfo.h"
@@ -97,6 +98,14 @@ public:
          return;
       }
 
+      auto sandboxSubprocess = std::make_unique<PluginSandboxSubprocess>();
+
+      if (sandboxSubprocess->initialiseFromCommandLine(commandLine, kSandboxProcessUID))
+      {
+         storedSandboxSubprocess = std::move(sandboxSubprocess);
+         return;
+      }
+
       mainWindow = std::make_unique<MainWindow>("bespoke synth");
 
       juce::PropertiesFile::Options options;
@@ -193,6 +202,7 @@ public:
 private:
    std::unique_ptr<MainWindow> mainWindow;
    std::unique_ptr<PluginScannerSubprocess> storedScannerSubprocess;
+   std::unique_ptr<PluginSandboxSubprocess> storedSandboxSubprocess;
 };
 
 //==============================================================================
@@ -112,6 +112,7 @@ ModularSynth::~ModularSynth()
    DeleteAllModules();
 
    delete mGlobalRecordBuffer;
+   delete mNoteOutputQueue;
    mAudioPluginFormatManager.reset();
    mKnownPluginList.reset();
 
@@ -311,6 +312,14 @@ void ModularSynth::InitIOBuffers(int inputChannelCount, int outputChannelCount)
       mInputBuffers.push_back(new float[gBufferSize]);
    for (int i = 0; i < outputChannelCount; ++i)
       mOutputBuffers.push_back(new float[gBufferSize]);
+
+   int oversampling = UserPrefs.oversampling.Get();
+   mInputUpsamplers.resize(inputChannelCount);
+   for (auto& upsampler : mInputUpsamplers)
+      upsampler.Setup(oversampling, gBufferSize / oversampling);
+   mOutputDownsamplers.resize(outputChannelCount);
+   for (auto& downsampler : mOutputDownsamplers)
+      downsampler.Setup(oversampling, gBufferSize / oversampling);
 }
 
 //static
@@ -375,6 +384,7 @@ void ModularSynth::Poll()
          p->Poll();
       mUILayerModuleContainer.Poll();
       mModuleContainer.Poll();
+      mModulationGraph.Poll();
    }
 
    if (mShowLoadStatePopup)
@@ -643,6 +653,7 @@ void ModularSynth::Draw()
       float moduleX, moduleY;
       mLissajousDrawers[i]->GetPosition(moduleX, moduleY);
       IAudioSource* source = dynamic_cast<IAudioSource*>(mLissajousDrawers[i]);
+      source->GetVizBuffer()->MarkViewed();
       DrawLissajous(source->GetVizBuffer(), moduleX, moduleY - 240, 240, 240);
    }
 
@@ -2264,8 +2275,11 @@ void ModularSynth::OnModuleDeleted(IDrawableModule* module)
       RemoveFromVector(cable, mPatchCables);
 
    RemoveFromVector(dynamic_cast<IAudioSource*>(module), mSources);
+   mLatencyCompensation.Update(mSources);
+   AssignSoleTargets();
    RemoveFromVector(module, mLissajousDrawers);
    TheTransport->RemoveAudioPoller(dynamic_cast<IAudioPoller*>(module));
+   mNoteOutputQueue->RemoveEventsForModule(module); //held events would otherwise play into it after it's deleted
    //delete module; TODO(Ryan) deleting is hard... need to clear out everything with a reference to this, or switch to smart pointers
 
    if (module == TheChaosEngine)
@@ -2376,8 +2390,6 @@ void ModularSynth::AudioOut(float* const* output, int bufferSize, int nChannels)
    ScopedMutex mutex(&mAudioThreadMutex, "audioOut()");
 
    /////////// AUDIO PROCESSING STARTS HERE /////////////
-   mNoteOutputQueue->Process();
-
    int oversampling = UserPrefs.oversampling.Get();
 
    assert(bufferSize * oversampling == mIOBufferSize);
@@ -2392,11 +2404,19 @@ void ModularSynth::AudioOut(float* const* output, int bufferSize, int nChannels)
 
       double elapsed = gInvSampleRateMs * mIOBufferSize;
       gTime += elapsed;
+      mNoteOutputQueue->Process(gTime + elapsed);
       TheTransport->Advance(elapsed);
 
       //process all audio
       for (int i = 0; i < mSources.size(); ++i)
-         mSources[i]->Process(gTime);
+      {
+         mLatencyCompensation.PreProcess(mSources[i]);
+         if (!mSources[i]->UpdateSleep())
+            mSources[i]->Process(gTime);
+         mLatencyCompensation.PostProcess(mSources[i]);
+      }
+
+      mModulationGraph.FlushUpdates();
 
       if (gTime - mLastClapboardTime < 100)
       {
@@ -2421,17 +2441,9 @@ void ModularSynth::AudioOut(float* const* output, int bufferSize, int nChannels)
          }
          else
          {
-            for (int sampleIndex = 0; sampleIndex < gBufferSize / oversampling; ++sampleIndex)
-            {
-               output[ch][sampleIndex] = 0;
-               for (int subsampleIndex = 0; subsampleIndex < oversampling; ++subsampleIndex)
-               {
-                  float sample = mOutputBuffers[ch][sampleIndex * oversampling + subsampleIndex];
-                  output[ch][sampleIndex] += sample / oversampling;
-                  if (ch < 2)
-                     mGlobalRecordBuffer->Write(sample, ch);
-               }
-            }
+            if (ch < 2)
+               mGlobalRecordBuffer->WriteChunk(mOutputBuffers[ch], gBufferSize, ch);
+            mOutputDownsamplers[ch].Downsample(mOutputBuffers[ch], output[ch], gBufferSize / oversampling);
          }
       }
    }
@@ -2463,10 +2475,8 @@ void ModularSynth::AudioIn(const float* const* input, int bufferSize, int nChann
       }
       else
       {
-         for (int sampleIndex = 0; sampleIndex < bufferSize * oversampling; ++sampleIndex)
-         {
-            mInputBuffers[i][sampleIndex] = input[i][sampleIndex / oversampling];
-         }
+         float* upsampled = mInputUpsamplers[i].Upsample(input[i], bufferSize);
+         BufferCopy(mInputBuffers[i], upsampled, bufferSize * oversampling);
       }
    }
 }
@@ -2608,11 +2618,69 @@ void ModularSynth::ArrangeAudioSourceDependencies()
       mHasCircularDependency = false;
    }
 
+   {
+      ScopedMutex mutex(&mAudioThreadMutex, "ArrangeAudioSourceDependencies()");
+      if (mHasCircularDependency)
+         mLatencyCompensation.Clear(); //path latency is meaningless in a loop
+      else
+         mLatencyCompensation.Update(mSources);
+      AssignSoleTargets();
+   }
+
    /*ofLog() << "new ordering:";
    for (int i=0; i<mSources.size(); ++i)
       ofLog() << dynamic_cast<IDrawableModule*>(mSources[i])->Name();*/
 }
 
+//finds the single-producer/single-consumer audio connections, where the producer can hand its buffer over rather than mixing it in. call with the audio thread locked.
+void ModularSynth::AssignSoleTargets()
+{
+   auto carriesAudio = [](PatchCableSource* cableSource)
+   {
+      return cableSource->GetConnectionType() == kConnectionType_Audio || cableSource->GetConnectionType() == kConnectionType_Special;
+   };
+
+   std::map<IAudioReceiver*, int> inputCounts;
+   for (auto* source : mSources)
+   {
+      IDrawableModule* module = dynamic_cast<IDrawableModule*>(source);
+      if (module == nullptr)
+         continue;
+      for (auto* cableSource : module->GetPatchCableSources())
+      {
+         if (!carriesAudio(cableSource))
+            continue;
+         for (auto* cable : cableSource->GetPatchCables())
+         {
+            IAudioReceiver* receiver = dynamic_cast<IAudioReceiver*>(cable->GetTarget());
+            if (receiver != nullptr)
+               ++inputCounts[receiver];
+         }
+      }
+   }
+
+   for (auto* source : mSources)
+   {
+      IAudioReceiver* soleTarget = nullptr;
+      IDrawableModule* module = dynamic_cast<IDrawableModule*>(source);
+      if (module != nullptr && source->GetNumTargets() == 1)
+      {
+         int numOutputs = 0;
+         for (auto* cableSource : module->GetPatchCableSources())
+         {
+            if (carriesAudio(cableSource))
+               numOutputs += (int)cableSource->GetPatchCables().size();
+         }
+
+         IAudioReceiver* target = source->GetTarget();
+         //only hand buffers to receivers that process and reset their input every block
+         if (numOutputs == 1 && target != nullptr && inputCounts[target] == 1 && VectorContains(dynamic_cast<IAudioSource*>(target), mSources))
+            soleTarget = target;
+      }
+      source->SetSoleTarget(soleTarget);
+   }
+}
+
 void ModularSynth::FindCircularDependencies()
 {
    ClearCircularDependencyMarkers();
@@ -2698,6 +2766,7 @@ void ModularSynth::ResetLayout()
 
    mDeletedModules.clear();
    mSources.clear();
+   mLatencyCompensation.Clear();
    mLissajousDrawers.clear();
    mMoveModule = nullptr;
    TheTransport->ClearListenersAndPollers();
@@ -2727,7 +2796,6 @@ void ModularSynth::ResetLayout()
    delete TheSaveDataPanel;
    delete mQuickSpawn;
    delete mUserPrefsEditor;
-   delete mNoteOutputQueue;
 
    TitleBar* titleBar = new TitleBar();
    titleBar->SetPosition(0, 0);
@@ -2793,7 +2861,10 @@ void ModularSynth::ResetLayout()
 
    SetUIScale(UserPrefs.ui_scale.Get());
 
-   mNoteOutputQueue = new NoteOutputQueue();
+   if (mNoteOutputQueue == nullptr)
+      mNoteOutputQueue = new NoteOutputQueue();
+   else
+      mNoteOutputQueue->Clear(); //held events point at modules we just deleted
 }
 
 bool ModularSynth::LoadLayoutFromFile(std::string jsonFile, bool makeDefaultLayout /*= true*/)
@@ -3053,13 +3124,14 @@ void ModularSynth::GrabSample(ChannelBuffer* data, std::string name, bool window
       const int fadeSamples = 15;
       if (length > fadeSamples * 2) //only window if there's enough space
       {
+         ChannelBuffer* heldData = mHeldSample->EditData();
          for (int i = 0; i < fadeSamples; ++i)
          {
-            for (int ch = 0; ch < mHeldSample->NumChannels(); ++ch)
+            for (int ch = 0; ch < heldData->NumActiveChannels(); ++ch)
             {
                float fade = float(i) / fadeSamples;
-               mHeldSample->Data()->GetChannel(ch)[i] *= fade;
-               mHeldSample->Data()->GetChannel(ch)[length - 1 - i] *= fade;
+               heldData->GetChannel(ch)[i] *= fade;
+               heldData->GetChannel(ch)[length - 1 - i] *= fade;
             }
          }
       }
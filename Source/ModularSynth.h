@@ -15,6 +15,9 @@
 #include "ModuleContainer.h"
 #include "Minimap.h"
 #include "LockFreeQueue.h"
+#include "LatencyCompensation.h"
+#include "Oversampler.h"
+#include "ModulationGraph.h"
 #include <thread>
 
 #ifdef BESPOKE_LINUX
@@ -224,6 +227,7 @@ public:
    juce::OpenGLContext* GetOpenGLContext() { return mOpenGLContext; }
    IDrawableModule* GetLastClickedModule() const;
    EffectFactory* GetEffectFactory() { return &mEffectFactory; }
+   ModulationGraph* GetModulationGraph() { return &mModulationGraph; }
    const std::vector<IDrawableModule*>& GetGroupSelectedModules() const { return mGroupSelectedModules; }
    void SetGroupSelectedModules(std::list<IDrawableModule*> modules);
    bool ShouldAccentuateActiveModules() const;
@@ -327,6 +331,7 @@ private:
    void TriggerClapboard();
    void DoAutosave();
    void FindCircularDependencies();
+   void AssignSoleTargets();
    bool FindCircularDependencySearch(std::list<IAudioSource*> chain, IAudioSource* searchFrom);
    void ClearCircularDependencyMarkers();
    bool IsCurrentSaveStateATemplate() const;
@@ -346,6 +351,8 @@ private:
    int mIOBufferSize{ 0 };
 
    std::vector<IAudioSource*> mSources;
+   LatencyCompensation mLatencyCompensation;
+   ModulationGraph mModulationGraph;
    std::vector<IDrawableModule*> mLissajousDrawers;
    std::vector<IDrawableModule*> mDeletedModules;
    bool mHasCircularDependency{ false };
@@ -481,6 +488,8 @@ private:
 
    std::vector<float*> mInputBuffers;
    std::vector<float*> mOutputBuffers;
+   std::vector<Oversampler> mInputUpsamplers; //for UserPrefs.oversampling, between the device rate and gSampleRate
+   std::vector<Oversampler> mOutputDownsamplers;
 
    std::unique_ptr<juce::AudioPluginFormatManager> mAudioPluginFormatManager;
    std::unique_ptr<juce::KnownPluginList> mKnownPluginList;
@@ -62,37 +62,44 @@ float ModulationChain::GetIndividualValue(int samplesIn) const
 
 void ModulationChain::SetValue(float value)
 {
+   ++mRevision;
    mRamp.Start(gTime, value, gTime + gInvSampleRateMs * gBufferSize);
 }
 
 void ModulationChain::RampValue(double time, float from, float to, double length)
 {
+   ++mRevision;
    mRamp.Start(time, from, to, time + length);
 }
 
 void ModulationChain::SetLFO(NoteInterval interval, float amount)
 {
+   ++mRevision;
    mLFO.SetPeriod(interval);
    mLFOAmount = amount;
 }
 
 void ModulationChain::AppendTo(ModulationChain* chain)
 {
+   ++mRevision;
    mPrev = chain;
 }
 
 void ModulationChain::SetSidechain(ModulationChain* chain)
 {
+   ++mRevision;
    mSidechain = chain;
 }
 
 void ModulationChain::MultiplyIn(ModulationChain* chain)
 {
+   ++mRevision;
    mMultiplyIn = chain;
 }
 
 void ModulationChain::CreateBuffer()
 {
+   ++mRevision;
    if (mBuffer == nullptr)
       mBuffer = new float[gBufferSize];
    Clear(mBuffer, gBufferSize);
@@ -100,6 +107,7 @@ void ModulationChain::CreateBuffer()
 
 void ModulationChain::FillBuffer(float* buffer)
 {
+   ++mRevision;
    if (mBuffer != nullptr)
       BufferCopy(mBuffer, buffer, gBufferSize);
 }
@@ -111,6 +119,65 @@ float ModulationChain::GetBufferValue(int sampleIdx)
    return 0;
 }
 
+ModulationBlock ModulationChain::GetBlock()
+{
+   int revision = GetRevision();
+   if (mBlockTime != gTime || mBlockRevision != revision)
+   {
+      if (mBlock.empty())
+         mBlock.resize(gBufferSize); //only chains that are actually read per-sample need one
+
+      mBlockConstant = IsConstantOverBuffer();
+      if (mBlockConstant)
+      {
+         mBlock[0] = GetValue(0);
+      }
+      else
+      {
+         for (int i = 0; i < gBufferSize; ++i)
+            mBlock[i] = GetValue(i);
+      }
+
+      mBlockTime = gTime;
+      mBlockRevision = revision;
+   }
+
+   return ModulationBlock{ mBlock.data(), mBlockConstant ? 0 : ~0 };
+}
+
+bool ModulationChain::IsIndividualConstantOverBuffer() const
+{
+   if (mLFOAmount != 0 || mBuffer != nullptr)
+      return false;
+   return mRamp.IsConstantBetween(gTime, gTime + gInvSampleRateMs * gBufferSize);
+}
+
+bool ModulationChain::IsConstantOverBuffer() const
+{
+   if (!IsIndividualConstantOverBuffer())
+      return false;
+   if (mMultiplyIn && !mMultiplyIn->IsIndividualConstantOverBuffer())
+      return false;
+   if (mSidechain && !mSidechain->IsIndividualConstantOverBuffer())
+      return false;
+   if (mPrev && !mPrev->IsConstantOverBuffer())
+      return false;
+   return true;
+}
+
+//only ever increases, so the sum changes whenever anything this chain reads from changes
+int ModulationChain::GetRevision() const
+{
+   int revision = mRevision;
+   if (mMultiplyIn)
+      revision += mMultiplyIn->mRevision;
+   if (mSidechain)
+      revision += mSidechain->mRevision;
+   if (mPrev)
+      revision += mPrev->GetRevision();
+   return revision;
+}
+
 Modulations::Modulations(bool isGlobalEffect)
 {
    mVoiceModulations.resize(kNumVoices);
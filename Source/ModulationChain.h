@@ -28,6 +28,16 @@
 #include "Ramp.h"
 #include "LFO.h"
 
+//a buffer's worth of modulation values. indexing is branch-free: a constant block masks every index down to its one value.
+struct ModulationBlock
+{
+   float operator[](int samplesIn) const { return mValues[samplesIn & mIndexMask]; }
+   bool IsConstant() const { return mIndexMask == 0; }
+
+   const float* mValues{ nullptr };
+   int mIndexMask{ 0 };
+};
+
 class ModulationChain
 {
 public:
@@ -43,8 +53,13 @@ public:
    void CreateBuffer();
    void FillBuffer(float* buffer);
    float GetBufferValue(int sampleIdx);
+   ModulationBlock GetBlock(); //GetValue() for every sample of the current buffer, rendered once and shared by everything that reads this chain
 
 private:
+   bool IsIndividualConstantOverBuffer() const;
+   bool IsConstantOverBuffer() const;
+   int GetRevision() const;
+
    Ramp mRamp;
    LFO mLFO;
    float mLFOAmount{ 0 };
@@ -52,6 +67,12 @@ private:
    ModulationChain* mPrev{ nullptr };
    ModulationChain* mSidechain{ nullptr };
    ModulationChain* mMultiplyIn{ nullptr };
+
+   int mRevision{ 0 }; //bumped whenever something changes what GetValue() would return, so a rendered block knows it's stale
+   std::vector<float> mBlock;
+   bool mBlockConstant{ false };
+   double mBlockTime{ -1 };
+   int mBlockRevision{ -1 };
 };
 
 struct ModulationParameters
@@ -71,6 +92,8 @@ struct ModulationParameters
    ModulationChain* pressure{ nullptr };
    float pan{ 0 };
 
+   static ModulationBlock GetBlock(ModulationChain* chain, const float& defaultValue) { return chain ? chain->GetBlock() : ModulationBlock{ &defaultValue, 0 }; }
+
    static constexpr float kDefaultPitchBend{ 0 };
    static constexpr float kDefaultModWheel{ 0 };
    static constexpr float kDefaultPressure{ .5f };
@@ -0,0 +1,219 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ModulationGraph.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "ModulationGraph.h"
+#include "ModularSynth.h"
+#include "IModulator.h"
+#include "Slider.h"
+
+#include <map>
+
+ModulationGraph::ModulationGraph()
+{
+   mPendingUpdates.reserve(1024);
+}
+
+void ModulationGraph::OnModulatorChanged(FloatSlider* slider)
+{
+   std::lock_guard<std::mutex> lock(mRegistryMutex);
+   if (slider->GetModulator() != nullptr)
+      mModulatedSliders.insert(slider);
+   else
+      mModulatedSliders.erase(slider);
+   mDirty = true;
+}
+
+void ModulationGraph::OnSliderDeleted(FloatSlider* slider)
+{
+   {
+      std::lock_guard<std::mutex> lock(mRegistryMutex);
+      mModulatedSliders.erase(slider);
+   }
+
+   //make sure the audio thread can't reach it through the current program before it's gone. even if it's not registered anymore, it
+   //can still be in mNodes until the next Poll() (its modulator was removed just before it got deleted).
+   //mNodes only changes on this thread, so we can look without locking, and only lock if there's something to clear.
+   bool inProgram = false;
+   for (const auto& node : mNodes)
+   {
+      if (node.mSlider == slider)
+         inProgram = true;
+   }
+   if (!inProgram)
+      return;
+
+   ScopedMutex mutex(TheSynth->GetAudioMutex(), "ModulationGraph::OnSliderDeleted()");
+   for (auto& node : mNodes)
+   {
+      if (node.mSlider == slider)
+         node.mSlider = nullptr;
+   }
+   mDirty = true;
+}
+
+void ModulationGraph::Poll()
+{
+   if (mDirty.exchange(false))
+      Compile();
+}
+
+void ModulationGraph::Compile()
+{
+   std::vector<FloatSlider*> sliders;
+   {
+      std::lock_guard<std::mutex> lock(mRegistryMutex);
+      sliders.assign(mModulatedSliders.begin(), mModulatedSliders.end());
+   }
+
+   std::map<FloatSlider*, int> indices;
+   for (int i = 0; i < (int)sliders.size(); ++i)
+      indices[sliders[i]] = i;
+
+   //a modulator depends on any modulated sliders on its own module (its inputs, ranges, etc)
+   std::vector<std::vector<int>> dependencies(sliders.size());
+   for (int i = 0; i < (int)sliders.size(); ++i)
+   {
+      auto* modulatorModule = dynamic_cast<IDrawableModule*>(sliders[i]->GetModulator());
+      if (modulatorModule == nullptr)
+         continue;
+      for (auto* control : modulatorModule->GetUIControls())
+      {
+         auto iter = indices.find(dynamic_cast<FloatSlider*>(control));
+         if (iter != indices.end() && iter->second != i)
+            dependencies[i].push_back(iter->second);
+      }
+   }
+
+   //topological sort. whatever can't be placed is part of a loop.
+   std::vector<int> order;
+   std::vector<int> newIndices(sliders.size(), -1);
+   bool placedAny = true;
+   while (placedAny)
+   {
+      placedAny = false;
+      for (int i = 0; i < (int)sliders.size(); ++i)
+      {
+         if (newIndices[i] != -1)
+            continue;
+         bool ready = true;
+         for (int dependency : dependencies[i])
+         {
+            if (newIndices[dependency] == -1)
+               ready = false;
+         }
+         if (ready)
+         {
+            newIndices[i] = (int)order.size();
+            order.push_back(i);
+            placedAny = true;
+         }
+      }
+   }
+
+   std::vector<Node> nodes(order.size());
+   for (int i = 0; i < (int)order.size(); ++i)
+   {
+      nodes[i].mSlider = sliders[order[i]];
+      for (int dependency : dependencies[order[i]])
+         nodes[i].mDependencies.push_back(newIndices[dependency]);
+   }
+
+   if (order.size() < sliders.size())
+      ofLog() << "modulation loop detected, " << sliders.size() - order.size() << " sliders will be evaluated per-sample";
+
+   std::vector<float> values(nodes.size() * gBufferSize);
+
+   {
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "ModulationGraph::Compile()");
+      for (auto& node : mNodes)
+      {
+         if (node.mSlider != nullptr)
+            node.mSlider->SetModulationNode(-1);
+      }
+      for (int i = 0; i < (int)nodes.size(); ++i)
+         nodes[i].mSlider->SetModulationNode(i);
+      mNodes.swap(nodes);
+      mValues.swap(values);
+   }
+}
+
+float ModulationGraph::GetValue(int nodeIndex, int samplesIn)
+{
+   Node& node = mNodes[nodeIndex];
+   if (node.mSlider->HasLowResModulation())
+      samplesIn = 0; //only ever evaluated once per buffer
+
+   if (node.mRenderedTime != gTime)
+   {
+      node.mRenderedTime = gTime;
+      node.mRenderedCount = 0;
+   }
+
+   if (samplesIn >= node.mRenderedCount)
+   {
+      if (node.mRendering) //we're inside our own modulator, a loop that the compile didn't see (through another module)
+         return *node.mSlider->GetVar();
+
+      if (samplesIn > 0)
+         node.mNeedsWholeBuffer = true;
+      Render(nodeIndex, node.mNeedsWholeBuffer ? gBufferSize : samplesIn + 1);
+   }
+
+   return mValues[nodeIndex * gBufferSize + samplesIn];
+}
+
+void ModulationGraph::Render(int nodeIndex, int renderCount)
+{
+   Node& node = mNodes[nodeIndex];
+   node.mRendering = true;
+
+   for (int dependency : node.mDependencies)
+   {
+      if (mNodes[dependency].mSlider != nullptr)
+         GetValue(dependency, renderCount - 1);
+   }
+
+   float* values = &mValues[nodeIndex * gBufferSize];
+   for (int i = node.mRenderedCount; i < renderCount; ++i)
+      values[i] = node.mSlider->EvaluateModulation(i);
+   node.mRenderedCount = renderCount;
+
+   node.mRendering = false;
+}
+
+void ModulationGraph::QueueUpdate(FloatSlider* slider)
+{
+   mPendingUpdates.push_back(slider);
+}
+
+void ModulationGraph::FlushUpdates()
+{
+   double time = gTime + gBufferSize * gInvSampleRateMs;
+   for (size_t i = 0; i < mPendingUpdates.size(); ++i) //listeners can compute other sliders and queue more, so no iterators
+      mPendingUpdates[i]->SendPendingUpdate(time);
+   mPendingUpdates.clear();
+}
@@ -0,0 +1,79 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ModulationGraph.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+
+class FloatSlider;
+
+//every modulated slider, compiled into a dependency-ordered list of nodes whenever modulation gets repatched.
+//on the audio thread, the first time a node's value is asked for in a buffer, its modulator gets evaluated for the buffer (after the
+//nodes it reads from) into flat per-node storage, and everything else that buffer just reads that back.
+//sliders that modulate each other in a loop are left out, and keep evaluating their modulators on demand.
+//this is also where sliders with FloatSlider::kUpdatePerBuffer queue up their one notification for the buffer.
+class ModulationGraph
+{
+public:
+   ModulationGraph();
+
+   void OnModulatorChanged(FloatSlider* slider); //any thread
+   void OnSliderDeleted(FloatSlider* slider); //main thread
+   void Poll(); //main thread, recompiles if anything changed
+
+   float GetValue(int nodeIndex, int samplesIn); //audio thread, for FloatSlider::DoCompute()
+   void QueueUpdate(FloatSlider* slider); //audio thread, for FloatSlider::DoCompute()
+   void FlushUpdates(); //audio thread, once everything has processed the buffer
+
+private:
+   struct Node
+   {
+      FloatSlider* mSlider{ nullptr };
+      std::vector<int> mDependencies; //nodes that this one's modulator reads from, all earlier in the list
+      double mRenderedTime{ -1 };
+      int mRenderedCount{ 0 };
+      bool mNeedsWholeBuffer{ false }; //someone has asked for samples past the first, so render them all up front from now on
+      bool mRendering{ false };
+   };
+
+   void Compile();
+   void Render(int nodeIndex, int renderCount);
+
+   std::mutex mRegistryMutex;
+   std::set<FloatSlider*> mModulatedSliders;
+   std::atomic<bool> mDirty{ false };
+
+   //only changed with the audio thread locked
+   std::vector<Node> mNodes;
+   std::vector<float> mValues; //mNodes.size() * gBufferSize
+
+   //audio thread only. always empty outside of ModularSynth::AudioOut(), so sliders don't need to take themselves out of it.
+   std::vector<FloatSlider*> mPendingUpdates;
+};
@@ -91,8 +91,15 @@ float ModulatorExpression::Value(int samplesIn)
    ComputeSliders(samplesIn);
    if (mExpressionValid)
    {
+      std::array<float, 6> inputs{ mExpressionInput, mA, mB, mC, mD, mE };
+      if (!mTimeVarying && mCachedValueValid && inputs == mCachedValueInputs)
+         return mCachedValue;
+
       mT = (gTime + samplesIn * gInvSampleRateMs) * .001;
-      return mExpression.value();
+      mCachedValue = mExpression.value();
+      mCachedValueInputs = inputs;
+      mCachedValueValid = true;
+      return mCachedValue;
    }
 
    if (GetSliderTarget())
@@ -114,10 +121,29 @@ void ModulatorExpression::PostRepatch(PatchCableSource* cableSource, bool fromUs
 void ModulatorExpression::TextEntryComplete(TextEntry* entry)
 {
    mExpressionValid = false;
+   mCachedValueValid = false;
+   mGraphValid = false;
    exprtk::parser<float> parser;
    mExpressionValid = parser.compile(mEntryString, mExpression);
    if (mExpressionValid)
+   {
       parser.compile(mEntryString, mExpressionDraw);
+
+      //if it reads t or assigns to anything, the same inputs won't always give the same output
+      std::vector<std::string> variables;
+      exprtk::collect_variables(mEntryString, variables);
+      mTimeVarying = false;
+      for (const char* assignment : { ":=", "+=", "-=", "*=", "/=", "%=" })
+      {
+         if (mEntryString.find(assignment) != std::string::npos)
+            mTimeVarying = true;
+      }
+      for (const auto& variable : variables)
+      {
+         if (variable == "t" || variable == "T")
+            mTimeVarying = true;
+      }
+   }
 }
 
 void ModulatorExpression::DrawModule()
@@ -149,10 +175,24 @@ void ModulatorExpression::DrawModule()
       ofBeginShape();
       float drawMinOutput = mLastDrawMinOutput;
       float drawMaxOutput = mLastDrawMaxOutput;
+
+      //only re-evaluate the curve when something it depends on has changed
+      std::array<float, 7> graphInputs{ mExpressionInputSlider->GetMin(), mExpressionInputSlider->GetMax(), mA, mB, mC, mD, mE };
+      if (mTimeVarying || !mGraphValid || graphInputs != mGraphInputs)
+      {
+         mGraph.resize(kGraphWidth + 1);
+         for (int i = 0; i <= kGraphWidth; ++i)
+         {
+            mExpressionInputDraw = ofMap(i, 0, kGraphWidth, mExpressionInputSlider->GetMin(), mExpressionInputSlider->GetMax());
+            mGraph[i] = mExpressionDraw.value();
+         }
+         mGraphInputs = graphInputs;
+         mGraphValid = true;
+      }
+
       for (int i = 0; i <= kGraphWidth; ++i)
       {
-         mExpressionInputDraw = ofMap(i, 0, kGraphWidth, mExpressionInputSlider->GetMin(), mExpressionInputSlider->GetMax());
-         float output = mExpressionDraw.value();
+         float output = mGraph[i];
          ofVertex(i + kGraphX, ofMap(output, drawMinOutput, drawMaxOutput, kGraphHeight, 0) + kGraphY);
 
          if (i == 0)
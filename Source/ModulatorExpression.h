@@ -94,4 +94,13 @@ private:
    bool mExpressionValid{ false };
    float mLastDrawMinOutput{ 0 };
    float mLastDrawMaxOutput{ 1 };
+
+   //exprtk evaluates one value at a time, so avoid evaluating at all when nothing it reads has changed
+   bool mTimeVarying{ false };
+   bool mCachedValueValid{ false };
+   std::array<float, 6> mCachedValueInputs{};
+   float mCachedValue{ 0 };
+   bool mGraphValid{ false };
+   std::array<float, 7> mGraphInputs{}; //the input slider's range, and a-e
+   std::vector<float> mGraph;
 };
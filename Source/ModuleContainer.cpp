@@ -74,19 +74,45 @@ void ModuleContainer::PreDrawUnclipped()
 
 void ModuleContainer::DrawModules()
 {
+   mCullOffscreenModules = ShouldCullOffscreenModules();
+
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
    {
-      if (!mModules[i]->AlwaysOnTop())
+      if (!mModules[i]->AlwaysOnTop() && !IsOffscreen(mModules[i]))
          mModules[i]->Draw();
    }
 
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
    {
-      if (mModules[i]->AlwaysOnTop())
+      if (mModules[i]->AlwaysOnTop() && !IsOffscreen(mModules[i]))
          mModules[i]->Draw();
    }
 }
 
+bool ModuleContainer::ShouldCullOffscreenModules() const
+{
+   //the draw rect is only meaningful for the main canvas, not for the ui layer or for offscreen renders like the save state screenshot
+   if (gNanoVG != gNanoVGRenderContexts[(int)NanoVGRenderContext::Main])
+      return false;
+
+   const ModuleContainer* container = this;
+   while (container->mOwner != nullptr && container->mOwner->GetOwningContainer() != nullptr)
+      container = container->mOwner->GetOwningContainer();
+   return container == TheSynth->GetRootContainer();
+}
+
+bool ModuleContainer::IsOffscreen(IDrawableModule* module) const
+{
+   if (!mCullOffscreenModules)
+      return false;
+
+   //leave some room for things that get drawn just outside of the module, like cable sources, beacons and highlights
+   const float kCullMargin = 50;
+   ofRectangle drawRect = TheSynth->GetDrawRect();
+   drawRect.grow(kCullMargin);
+   return !module->IsWithinRect(drawRect);
+}
+
 void ModuleContainer::DrawUnclipped()
 {
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
@@ -106,6 +132,69 @@ void ModuleContainer::PostRender()
 {
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
       mModules[i]->PostRender();
+
+   UpdateSpatialIndex();
+}
+
+void ModuleContainer::UpdateSpatialIndex()
+{
+   //module bounds can change in lots of ways (resizing, minimizing, cable sources moving around), so refresh them once per frame after drawing
+   for (auto* module : mModules)
+   {
+      mSpatialIndex.Update(module, GetHitTestBounds(module));
+      if (module->GetContainer())
+         module->GetContainer()->UpdateSpatialIndex();
+   }
+}
+
+void ModuleContainer::UpdateSpatialIndex(IDrawableModule* module)
+{
+   if (VectorContains(module, mModules))
+      mSpatialIndex.Update(module, GetHitTestBounds(module));
+}
+
+ofRectangle ModuleContainer::GetHitTestBounds(IDrawableModule* module) const
+{
+   //conservative bounds in container-local space, covering everything that IDrawableModule::TestClick() can respond to
+   const float kMargin = 10;
+
+   ofRectangle bounds = module->GetRect(K(local));
+   if (module->HasTitleBar())
+   {
+      bounds.y -= IDrawableModule::TitleBarHeight();
+      bounds.height += IDrawableModule::TitleBarHeight();
+   }
+
+   //cable sources are positioned in the owning container's space, not relative to the module's parent
+   ofVec2f toLocal = module->GetPosition(K(local)) - module->GetPosition();
+   int sourceIndex = 0;
+   while (PatchCableSource* source = module->GetPatchCableSource(sourceIndex))
+   {
+      ofRectangle sourceBounds = source->GetHoverBounds();
+      sourceBounds.x += toLocal.x;
+      sourceBounds.y += toLocal.y;
+      bounds = ofRectangle::include(bounds, sourceBounds);
+      ++sourceIndex;
+   }
+
+   bounds.grow(kMargin);
+   return bounds;
+}
+
+void ModuleContainer::SortByDepth(std::vector<IDrawableModule*>& modules)
+{
+   if (mModuleDepthDirty)
+   {
+      mModuleDepth.clear();
+      for (int i = 0; i < (int)mModules.size(); ++i)
+         mModuleDepth[mModules[i]] = i;
+      mModuleDepthDirty = false;
+   }
+
+   std::sort(modules.begin(), modules.end(), [this](IDrawableModule* a, IDrawableModule* b)
+             {
+                return mModuleDepth[a] < mModuleDepth[b];
+             });
 }
 
 void ModuleContainer::DrawPatchCables(bool parentMinimized, bool inFront)
@@ -148,6 +237,8 @@ void ModuleContainer::Clear()
       }
    }
    mModules.clear();
+   mSpatialIndex.Clear();
+   mModuleDepthDirty = true;
 }
 
 void ModuleContainer::Exit()
@@ -227,39 +318,50 @@ IDrawableModule* ModuleContainer::GetModuleAt(float x, float y)
          return modalItems[i];
    }
 
-   for (int i = 0; i < mModules.size(); ++i)
+   //only ask the modules whose bounds are near the point, in front-to-back order
+   std::vector<IDrawableModule*> candidates;
+   candidates.swap(mHitTestCandidates); //reuse allocation, but stay safe if a subcontainer query re-enters
+   candidates.clear();
+   mSpatialIndex.QueryPoint(x, y, candidates);
+   SortByDepth(candidates);
+
+   IDrawableModule* ret = nullptr;
+   for (auto* module : candidates)
    {
-      if (mModules[i]->AlwaysOnTop() && mModules[i]->TestClick(x, y, false, true))
+      if (module->AlwaysOnTop() && module->TestClick(x, y, false, true))
       {
-         ModuleContainer* subcontainer = mModules[i]->GetContainer();
+         ret = module;
+         ModuleContainer* subcontainer = module->GetContainer();
          if (subcontainer)
          {
             IDrawableModule* contained = subcontainer->GetModuleAt(x - subcontainer->GetOwnerPosition().x, y - subcontainer->GetOwnerPosition().y);
             if (contained)
-            {
-               return contained;
-            }
+               ret = contained;
          }
-         return mModules[i];
+         break;
       }
    }
-   for (int i = 0; i < mModules.size(); ++i)
+   if (ret == nullptr)
    {
-      if (!mModules[i]->AlwaysOnTop() && mModules[i]->TestClick(x, y, false, true))
+      for (auto* module : candidates)
       {
-         ModuleContainer* subcontainer = mModules[i]->GetContainer();
-         if (subcontainer)
+         if (!module->AlwaysOnTop() && module->TestClick(x, y, false, true))
          {
-            IDrawableModule* contained = subcontainer->GetModuleAt(x, y);
-            if (contained)
+            ret = module;
+            ModuleContainer* subcontainer = module->GetContainer();
+            if (subcontainer)
             {
-               return contained;
+               IDrawableModule* contained = subcontainer->GetModuleAt(x, y);
+               if (contained)
+                  ret = contained;
             }
+            break;
          }
-         return mModules[i];
       }
    }
-   return nullptr;
+
+   candidates.swap(mHitTestCandidates);
+   return ret;
 }
 
 ofVec2f ModuleContainer::GetDrawOffset()
@@ -279,10 +381,18 @@ float ModuleContainer::GetDrawScale() const
 void ModuleContainer::GetModulesWithinRect(ofRectangle rect, std::vector<IDrawableModule*>& output, bool ignorePinned /* = false */)
 {
    output.clear();
-   for (int i = 0; i < mModules.size(); ++i)
+
+   ofRectangle localRect = rect;
+   localRect.x -= GetOwnerPosition().x;
+   localRect.y -= GetOwnerPosition().y;
+   std::vector<IDrawableModule*> candidates;
+   mSpatialIndex.QueryRect(localRect, candidates);
+   SortByDepth(candidates);
+
+   for (auto* module : candidates)
    {
-      if (mModules[i]->IsWithinRect(rect) && mModules[i] != TheQuickSpawnMenu && mModules[i]->IsShowing() && (ignorePinned && !mModules[i]->Pinned()))
-         output.push_back(mModules[i]);
+      if (module->IsWithinRect(rect) && module != TheQuickSpawnMenu && module->IsShowing() && (ignorePinned && !module->Pinned()))
+         output.push_back(module);
    }
 }
 
@@ -298,6 +408,8 @@ void ModuleContainer::MoveToFront(IDrawableModule* module)
          for (int j = i; j > 0; --j)
             mModules[j] = mModules[j - 1];
          mModules[0] = module;
+         mModuleDepthDirty = true;
+         UpdateSpatialIndex(module);
 
          break;
       }
@@ -307,6 +419,7 @@ void ModuleContainer::MoveToFront(IDrawableModule* module)
 void ModuleContainer::AddModule(IDrawableModule* module)
 {
    mModules.push_back(module);
+   mModuleDepthDirty = true;
    MoveToFront(module);
    TheSynth->OnModuleAdded(module);
    module->SetOwningContainer(this);
@@ -321,10 +434,13 @@ void ModuleContainer::TakeModule(IDrawableModule* module)
    if (module->GetOwningContainer()->mOwner)
       module->GetOwningContainer()->mOwner->RemoveChild(module);
    RemoveFromVector(module, module->GetOwningContainer()->mModules);
+   module->GetOwningContainer()->mSpatialIndex.Remove(module);
+   module->GetOwningContainer()->mModuleDepthDirty = true;
 
    std::string newName = GetUniqueName(module->Name(), mModules);
 
    mModules.push_back(module);
+   mModuleDepthDirty = true;
    MoveToFront(module);
 
    ofVec2f offset = oldOwnerPos - GetOwnerPosition();
@@ -335,6 +451,7 @@ void ModuleContainer::TakeModule(IDrawableModule* module)
       mOwner->AddChild(module);
    else //root modulecontainer
       module->SetName(newName.c_str());
+   UpdateSpatialIndex(module);
 }
 
 void ModuleContainer::DeleteModule(IDrawableModule* module, bool fail /*= true*/)
@@ -346,6 +463,8 @@ void ModuleContainer::DeleteModule(IDrawableModule* module, bool fail /*= true*/
    {
       module->DoSpecialDelete();
       RemoveFromVector(module, mModules, fail);
+      mSpatialIndex.Remove(module);
+      mModuleDepthDirty = true;
       return;
    }
 
@@ -353,6 +472,8 @@ void ModuleContainer::DeleteModule(IDrawableModule* module, bool fail /*= true*/
       module->GetParent()->GetModuleParent()->RemoveChild(module);
 
    RemoveFromVector(module, mModules, fail);
+   mSpatialIndex.Remove(module);
+   mModuleDepthDirty = true;
    for (const auto iter : mModules)
    {
       if (iter->GetPatchCableSource())
@@ -30,6 +30,9 @@
 #include "OpenFrameworksPort.h"
 #include "IDrawableModule.h"
 #include "ofxJSONElement.h"
+#include "SpatialGrid.h"
+
+#include <unordered_map>
 
 class ModuleContainer
 {
@@ -46,6 +49,8 @@ public:
    void PreDrawUnclipped();
    void DrawUnclipped();
    void PostRender();
+   void UpdateSpatialIndex();
+   void UpdateSpatialIndex(IDrawableModule* module);
    void Poll();
    void Clear();
    void Exit();
@@ -94,9 +99,20 @@ public:
    static bool DoesModuleHaveMoreSaveData(FileStreamIn& in);
 
 private:
+   ofRectangle GetHitTestBounds(IDrawableModule* module) const;
+   bool ShouldCullOffscreenModules() const;
+   bool IsOffscreen(IDrawableModule* module) const;
+   void SortByDepth(std::vector<IDrawableModule*>& modules);
+
    std::vector<IDrawableModule*> mModules;
    IDrawableModule* mOwner{ nullptr };
 
+   SpatialGrid<IDrawableModule> mSpatialIndex;
+   std::unordered_map<IDrawableModule*, int> mModuleDepth;
+   bool mModuleDepthDirty{ true };
+   std::vector<IDrawableModule*> mHitTestCandidates;
+   bool mCullOffscreenModules{ false };
+
    ofVec2f mDrawOffset;
    float mDrawScale{ 1 };
 };
@@ -273,7 +273,7 @@ void MultitapDelay::DelayMPETap::Process(float* sampleOut, int offset, int ch)
          float modwheel = mModWheel ? mModWheel->GetValue(i) : ModulationParameters::kDefaultModWheel;
          if (pressure > 0)
          {
-            mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, MAX_GRAINS);
+            mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, DENSE_GRAIN_OVERLAP);
             mGranulator.mPosRandomizeMs = ofMap(pressure * pressure, 0, 1, 100, .03f);
          }
          mGranulator.mGrainLengthMs = ofMap(modwheel, -1, 1, 150-140, 150+140);
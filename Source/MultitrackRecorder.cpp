@@ -420,7 +420,7 @@ Sample* MultitrackRecorderTrack::BounceRecording()
    {
       sample = new Sample();
       sample->Create(mRecordingLength);
-      ChannelBuffer* data = sample->Data();
+      ChannelBuffer* data = sample->EditData();
       int channelCount = mRecordChunks[0]->NumActiveChannels();
       data->SetNumActiveChannels(channelCount);
 
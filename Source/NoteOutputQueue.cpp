@@ -26,9 +26,18 @@
 #include "NoteOutputQueue.h"
 #include "INoteSource.h"
 #include "ModularSynth.h"
+#include "IDrawableModule.h"
+#include "PatchCableSource.h"
+
+NoteOutputQueue::NoteOutputQueue()
+{
+   mScheduled.reserve(kMaxScheduled);
+}
 
 void NoteOutputQueue::QueuePlayNote(NoteOutput* target, NoteMessage note)
 {
+   LogDropped();
+
    PendingNoteOutput output;
    output.target = target;
    output.note = note;
@@ -37,6 +46,8 @@ void NoteOutputQueue::QueuePlayNote(NoteOutput* target, NoteMessage note)
 
 void NoteOutputQueue::QueueFlush(NoteOutput* target, double time)
 {
+   LogDropped();
+
    PendingNoteOutput output;
    output.target = target;
    output.isFlush = true;
@@ -44,25 +55,85 @@ void NoteOutputQueue::QueueFlush(NoteOutput* target, double time)
    mQueue.enqueue(output);
 }
 
-void NoteOutputQueue::Process()
+void NoteOutputQueue::LogDropped()
+{
+   int numDropped = mNumDropped.exchange(0);
+   if (numDropped > 0)
+      ofLog() << "note output queue full, dropped " << numDropped << " events";
+}
+
+void NoteOutputQueue::Schedule(const PendingNoteOutput& output)
+{
+   if (mScheduled.size() >= kMaxScheduled)
+   {
+      ++mNumDropped; //reported from the queueing thread, we can't log on the audio thread
+      return;
+   }
+
+   //keep same-time events in the order they were queued
+   auto insertAt = std::upper_bound(mScheduled.begin(), mScheduled.end(), output, [](const PendingNoteOutput& a, const PendingNoteOutput& b)
+                                    {
+                                       return a.note.time < b.note.time;
+                                    });
+   mScheduled.insert(insertAt, output);
+}
+
+void NoteOutputQueue::Process(double bufferEndTime)
 {
    assert(IsAudioThread());
 
    PendingNoteOutput output;
-   while (true)
-   {
-      bool hasData = mQueue.try_dequeue(output);
-      if (!hasData)
-         break;
+   while (mQueue.try_dequeue(output))
+      Schedule(output);
 
-      if (output.isFlush)
+   size_t numDue = 0;
+   while (numDue < mScheduled.size() && mScheduled[numDue].note.time < bufferEndTime)
+      ++numDue;
+
+   for (size_t i = 0; i < numDue; ++i)
+   {
+      const PendingNoteOutput& due = mScheduled[i];
+      if (due.isFlush)
       {
-         output.target->Flush(output.note.time);
+         due.target->Flush(due.note.time);
       }
       else
       {
-         //ofLog() << "playing queued note " << output.time << " " << output.pitch << " " << output.velocity << " " << gTime;
-         output.target->PlayNoteInternal(output.note, false);
+         //ofLog() << "playing queued note " << due.note.time << " " << due.note.pitch << " " << due.note.velocity << " " << gTime;
+         due.target->PlayNoteInternal(due.note, false);
       }
    }
+
+   mScheduled.erase(mScheduled.begin(), mScheduled.begin() + numDue);
+}
+
+void NoteOutputQueue::Clear()
+{
+   PendingNoteOutput output;
+   while (mQueue.try_dequeue(output))
+   {
+   }
+   mScheduled.clear();
+}
+
+void NoteOutputQueue::RemoveEventsForModule(IDrawableModule* module)
+{
+   auto isOwnedByModule = [module](const PendingNoteOutput& output)
+   {
+      INoteSource* source = output.target->GetNoteSource();
+      if (dynamic_cast<IDrawableModule*>(source) == module)
+         return true;
+      PatchCableSource* cableSource = source->GetPatchCableSource();
+      return cableSource != nullptr && cableSource->GetOwner() == module; //additional note cables
+   };
+
+   //anything still in the lock-free queue has to be drained first, to be able to filter it
+   PendingNoteOutput output;
+   while (mQueue.try_dequeue(output))
+   {
+      if (!isOwnedByModule(output))
+         Schedule(output);
+   }
+
+   mScheduled.erase(std::remove_if(mScheduled.begin(), mScheduled.end(), isOwnedByModule), mScheduled.end());
 }
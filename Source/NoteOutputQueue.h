@@ -29,14 +29,24 @@
 #include "ModulationChain.h"
 #include "INoteReceiver.h"
 
+#include <atomic>
+#include <vector>
+
 class NoteOutput;
+class IDrawableModule;
 
 class NoteOutputQueue
 {
 public:
+   NoteOutputQueue();
+
    void QueuePlayNote(NoteOutput* target, NoteMessage note);
    void QueueFlush(NoteOutput* target, double time);
-   void Process();
+   //dispatches everything due before bufferEndTime, in time order. later events are held until the buffer they land in.
+   void Process(double bufferEndTime);
+   void Clear();
+   //drops held events for the module's outputs. call with the audio thread locked.
+   void RemoveEventsForModule(IDrawableModule* module);
 
 private:
    struct PendingNoteOutput
@@ -46,5 +56,12 @@ private:
       NoteMessage note;
    };
 
+   void Schedule(const PendingNoteOutput& output);
+   void LogDropped();
+
    moodycamel::ReaderWriterQueue<PendingNoteOutput> mQueue;
+   std::vector<PendingNoteOutput> mScheduled; //sorted by time, audio thread only. never grows past kMaxScheduled, so it doesn't allocate
+   std::atomic<int> mNumDropped{ 0 };
+
+   static constexpr size_t kMaxScheduled = 1024;
 };
@@ -0,0 +1,259 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    Oversampler.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "Oversampler.h"
+#include "DropdownList.h"
+
+#include <cstring>
+
+namespace
+{
+   //the first stage does the real work of keeping the band above the original nyquist out, so it's the sharp one.
+   //later stages only have to separate images that are much further apart, so they can be short.
+   const int kFirstStageHalfLength = 12; //47 taps
+   const int kLaterStageHalfLength = 4; //15 taps
+   const double kKaiserBeta = 8; //around -80dB stopband
+
+   double BesselI0(double x)
+   {
+      double sum = 1;
+      double term = 1;
+      for (int k = 1; k < 50; ++k)
+      {
+         term *= (x / (2 * k)) * (x / (2 * k));
+         sum += term;
+         if (term < sum * 1e-12)
+            break;
+      }
+      return sum;
+   }
+
+   //kaiser-windowed half-band lowpass, 4*halfLength-1 taps long. every other tap is zero apart from the center one, which is .5,
+   //so we only store the 2*halfLength nonzero outer taps.
+   struct HalfBandTaps
+   {
+      explicit HalfBandTaps(int halfLength)
+      {
+         int numTaps = 2 * halfLength;
+         int center = 2 * halfLength - 1;
+         mTaps.resize(numTaps);
+         double sum = 0;
+         for (int k = 0; k < numTaps; ++k)
+         {
+            double n = 2 * k - center; //always odd
+            double sinc = sin(PI * n / 2) / (PI * n / 2);
+            double r = n / (center + 1);
+            double window = BesselI0(kKaiserBeta * sqrt(1 - r * r)) / BesselI0(kKaiserBeta);
+            mTaps[k] = .5 * sinc * window;
+            sum += mTaps[k];
+         }
+         for (int k = 0; k < numTaps; ++k)
+            mFloatTaps.push_back(float(mTaps[k] * .5 / sum)); //outer taps sum to .5, so with the center tap we have unity gain at dc
+      }
+
+      std::vector<double> mTaps;
+      std::vector<float> mFloatTaps;
+   };
+
+   const HalfBandTaps& GetTaps(int halfLength)
+   {
+      static const HalfBandTaps sFirstStage(kFirstStageHalfLength);
+      static const HalfBandTaps sLaterStage(kLaterStageHalfLength);
+      return halfLength == kFirstStageHalfLength ? sFirstStage : sLaterStage;
+   }
+
+   const HalfBandTaps& sTapsInit = GetTaps(kFirstStageHalfLength); //build at startup rather than on the audio thread
+   const HalfBandTaps& sLaterTapsInit = GetTaps(kLaterStageHalfLength);
+
+   inline float Dot(const float* a, const float* b, int length)
+   {
+      float sum = 0;
+      for (int k = 0; k < length; ++k)
+         sum += a[k] * b[k];
+      return sum;
+   }
+}
+
+void Oversampler::Stage::Setup(int halfLength, int maxInputSize)
+{
+   const HalfBandTaps& taps = GetTaps(halfLength);
+   mTaps = taps.mFloatTaps.data();
+   mNumTaps = (int)taps.mFloatTaps.size();
+   mHalfLength = halfLength;
+   mWork.assign(mNumTaps - 1 + maxInputSize, 0);
+   mCenterWork.assign(halfLength + maxInputSize, 0);
+}
+
+void Oversampler::Stage::Reset()
+{
+   std::fill(mWork.begin(), mWork.end(), 0.0f);
+   std::fill(mCenterWork.begin(), mCenterWork.end(), 0.0f);
+}
+
+//zero-stuffing and filtering, without the multiplies by zero: the even outputs come from the outer taps, and the odd outputs are the center tap, which is just a delay
+void Oversampler::Stage::Upsample(const float* input, float* output, int numSamples)
+{
+   const int history = mNumTaps - 1;
+   float* work = mWork.data();
+   BufferCopy(work + history, input, numSamples);
+
+   for (int i = 0; i < numSamples; ++i)
+   {
+      output[i * 2] = 2 * Dot(mTaps, work + i, mNumTaps); //taps are symmetric, so no need to reverse them
+      output[i * 2 + 1] = work[i + mHalfLength];
+   }
+
+   memmove(work, work + numSamples, history * sizeof(float));
+}
+
+//filtering and dropping every other sample, computing only the outputs we keep. numSamples is the number of output samples.
+void Oversampler::Stage::Downsample(const float* input, float* output, int numSamples)
+{
+   const int history = mNumTaps - 1;
+   const int centerHistory = mHalfLength;
+   float* work = mWork.data();
+   float* centerWork = mCenterWork.data();
+   for (int i = 0; i < numSamples; ++i)
+   {
+      work[history + i] = input[i * 2];
+      centerWork[centerHistory + i] = input[i * 2 + 1];
+   }
+
+   for (int i = 0; i < numSamples; ++i)
+      output[i] = Dot(mTaps, work + i, mNumTaps) + .5f * centerWork[i];
+
+   memmove(work, work + numSamples, history * sizeof(float));
+   memmove(centerWork, centerWork + numSamples, centerHistory * sizeof(float));
+}
+
+void Oversampler::Setup(int factor, int maxBlockSize)
+{
+   mFactor = 1;
+   mNumStages = 0;
+   while (mFactor < factor && mFactor < kMaxFactor)
+   {
+      mFactor *= 2;
+      ++mNumStages;
+   }
+
+   mCapacity = 0;
+   EnsureCapacity(maxBlockSize);
+}
+
+void Oversampler::EnsureCapacity(int numSamples)
+{
+   if (numSamples <= mCapacity)
+      return;
+
+   mCapacity = numSamples;
+   for (int i = 0; i < mNumStages; ++i)
+   {
+      int halfLength = (i == 0) ? kFirstStageHalfLength : kLaterStageHalfLength;
+      int stageInputSize = numSamples << i; //stage i runs between 2^i and 2^(i+1) times the base rate
+      mUpStages[i].Setup(halfLength, stageInputSize);
+      mDownStages[i].Setup(halfLength, stageInputSize);
+   }
+   for (auto& scratch : mScratch)
+      scratch.assign(numSamples * mFactor, 0);
+}
+
+void Oversampler::Reset()
+{
+   for (int i = 0; i < mNumStages; ++i)
+   {
+      mUpStages[i].Reset();
+      mDownStages[i].Reset();
+   }
+}
+
+float* Oversampler::Upsample(const float* input, int numSamples)
+{
+   EnsureCapacity(numSamples);
+
+   if (mNumStages == 0)
+   {
+      BufferCopy(mScratch[0].data(), input, numSamples);
+      return mScratch[0].data();
+   }
+
+   const float* src = input;
+   float* dst = nullptr;
+   int size = numSamples;
+   for (int i = 0; i < mNumStages; ++i)
+   {
+      dst = mScratch[i % 2].data();
+      mUpStages[i].Upsample(src, dst, size);
+      src = dst;
+      size *= 2;
+   }
+   return dst;
+}
+
+void Oversampler::Downsample(const float* input, float* output, int numSamples)
+{
+   EnsureCapacity(numSamples);
+
+   if (mNumStages == 0)
+   {
+      if (output != input)
+         BufferCopy(output, input, numSamples);
+      return;
+   }
+
+   //innermost stage first. if input is one of our scratch buffers, make sure the first stage doesn't write into it.
+   const float* src = input;
+   int size = numSamples << (mNumStages - 1);
+   int scratchIndex = (src == mScratch[0].data()) ? 1 : 0;
+   for (int i = mNumStages - 1; i >= 0; --i)
+   {
+      float* dst = (i == 0) ? output : mScratch[scratchIndex].data();
+      mDownStages[i].Downsample(src, dst, size);
+      src = dst;
+      scratchIndex = 1 - scratchIndex;
+      size /= 2;
+   }
+}
+
+//static
+int Oversampler::GetLatencySamples(int factor)
+{
+   //each stage delays by 2*halfLength-1 samples at its output rate on the way up, and the same at its input rate on the way down
+   double latency = 0;
+   for (int i = 0; (2 << i) <= factor && (2 << i) <= kMaxFactor; ++i)
+   {
+      int halfLength = (i == 0) ? kFirstStageHalfLength : kLaterStageHalfLength;
+      latency += (2 * halfLength - 1) / double(1 << i);
+   }
+   return (int)round(latency);
+}
+
+//static
+void Oversampler::FillDropdown(DropdownList* list, int maxFactor /*= 8*/)
+{
+   for (int factor = 1; factor <= maxFactor; factor *= 2)
+      list->AddLabel(ofToString(factor) + "x", factor);
+}
@@ -0,0 +1,81 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    Oversampler.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SynthGlobals.h"
+
+#include <vector>
+
+class DropdownList;
+
+//up/downsamples one channel by a power of two, as a cascade of 2x polyphase half-band stages.
+//upsampling and downsampling keep separate filter state, so one instance can wrap a nonlinear stage: Upsample(), process, Downsample().
+class Oversampler
+{
+public:
+   static constexpr int kMaxFactor = 16;
+
+   void Setup(int factor, int maxBlockSize); //resets filter state. allocates, so don't call this on the audio thread unless the factor changed.
+   int GetFactor() const { return mFactor; }
+   void Reset();
+
+   //returns numSamples * GetFactor() samples, valid until the next call to Upsample()
+   float* Upsample(const float* input, int numSamples);
+   //input holds numSamples * GetFactor() samples, and can be the pointer Upsample() returned. output can alias input.
+   void Downsample(const float* input, float* output, int numSamples);
+
+   //how late the output of an Upsample() -> Downsample() round trip is, in base rate samples
+   int GetLatencySamples() const { return GetLatencySamples(mFactor); }
+   static int GetLatencySamples(int factor);
+
+   static void FillDropdown(DropdownList* list, int maxFactor = 8);
+
+private:
+   struct Stage
+   {
+      void Setup(int halfLength, int maxInputSize);
+      void Reset();
+      void Upsample(const float* input, float* output, int numSamples);
+      void Downsample(const float* input, float* output, int numSamples);
+
+      const float* mTaps{ nullptr }; //the nonzero outer taps. the only other nonzero tap is the center one, which is .5
+      int mNumTaps{ 0 };
+      int mHalfLength{ 0 };
+      std::vector<float> mWork; //filter history followed by the current block
+      std::vector<float> mCenterWork; //downsampling only, history and block for the center tap phase
+   };
+
+   void EnsureCapacity(int numSamples);
+
+   int mFactor{ 1 };
+   int mNumStages{ 0 };
+   int mCapacity{ 0 };
+   Stage mUpStages[4];
+   Stage mDownStages[4];
+   std::vector<float> mScratch[2];
+};
@@ -58,6 +58,7 @@ PatchCable::~PatchCable()
 void PatchCable::SetCableTarget(IClickable* target)
 {
    mTarget = target;
+   mHoverBoundsValid = false;
    mTargetRadioButton = dynamic_cast<RadioButton*>(target);
    mAudioReceiverTarget = dynamic_cast<IAudioReceiver*>(target);
 }
@@ -67,6 +68,12 @@ void PatchCable::Render()
    PatchCablePos cable = GetPatchCablePos();
    mX = cable.start.x;
    mY = cable.start.y;
+   mHoverBounds.set(MIN(cable.plug.x, cable.end.x), MIN(cable.plug.y, cable.end.y), fabsf(cable.plug.x - cable.end.x), fabsf(cable.plug.y - cable.end.y));
+   mHoverBounds.grow(5);
+   mHoverBoundsValid = true;
+
+   if (IsOffscreen(cable))
+      return;
    ofVec2f cableFadeOut = cable.start * .47 + cable.end * .53f;
    ofVec2f cableFadeIn = cable.start * .53f + cable.end * .47f;
    float cableQuality = gDrawScale * UserPrefs.cable_quality.Get();
@@ -108,6 +115,7 @@ void PatchCable::Render()
             if (vizBuff == nullptr)
                vizBuff = audioSource->GetVizBuffer();
             assert(vizBuff);
+            vizBuff->MarkViewed(100); //just checking for activity, the actual drawing below asks for its own resolution
             int numSamples = vizBuff->Size();
             bool allZero = true;
             for (int ch = 0; ch < vizBuff->NumChannels(); ++ch)
@@ -324,6 +332,7 @@ void PatchCable::Render()
          float dx = (cable.plug.x - cable.start.x) / wireLength;
          float dy = (cable.plug.y - cable.start.y) / wireLength;
          float cableStepSize = ofClamp(wireLength / (100 * cableQuality), 1, 7);
+         vizBuff->MarkViewed(wireLength / cableStepSize);
 
          for (int ch = 0; ch < vizBuff->NumChannels(); ++ch)
          {
@@ -441,11 +450,34 @@ void PatchCable::Render()
    ofPopMatrix();
 }
 
+bool PatchCable::IsOffscreen(const PatchCablePos& cable) const
+{
+   if (mDragging || gNanoVG != gNanoVGRenderContexts[(int)NanoVGRenderContext::Main])
+      return false;
+
+   if (GetOwningModule()->GetOwningContainer() != TheSynth->GetRootContainer())
+      return false;
+
+   //the bezier stays within the hull of its control points, which are at most bezierStrength away from the start and plug
+   float bezierStrength = sqrtf((cable.plug - cable.start).lengthSquared()) * .15f;
+   ofRectangle bounds(cable.start, cable.start);
+   bounds = ofRectangle::include(bounds, ofRectangle(cable.plug, cable.plug));
+   bounds = ofRectangle::include(bounds, ofRectangle(cable.end, cable.end));
+   bounds.grow(bezierStrength + 20);
+   return !bounds.intersects(TheSynth->GetDrawRect());
+}
+
 bool PatchCable::MouseMoved(float x, float y)
 {
    x = TheSynth->GetMouseX(GetOwningModule()->GetOwningContainer());
    y = TheSynth->GetMouseY(GetOwningModule()->GetOwningContainer());
 
+   if (mHoverBoundsValid && !mDragging && !mHoverBounds.contains(x, y))
+   {
+      mHovered = false;
+      return false;
+   }
+
    PatchCablePos cable = GetPatchCablePos();
    mHovered = DistSqToLine(ofVec2f(x, y), cable.plug, cable.end) < 25 && gHoveredUIControl == nullptr;
 
@@ -103,6 +103,7 @@ protected:
 private:
    void SetCableTarget(IClickable* target);
    PatchCablePos GetPatchCablePos();
+   bool IsOffscreen(const PatchCablePos& cable) const;
    ofVec2f FindClosestSide(float x, float y, float w, float h, ofVec2f start, ofVec2f startDirection, ofVec2f& endDirection);
 
    PatchCableSource* mOwner{ nullptr };
@@ -113,6 +114,8 @@ private:
    IAudioReceiver* mAudioReceiverTarget{ nullptr };
 
    bool mHovered{ false };
+   ofRectangle mHoverBounds; //where the plug segment was last drawn, so mouse moves far from the cable can skip GetPatchCablePos()
+   bool mHoverBoundsValid{ false };
    bool mDragging{ false };
    ofVec2f mGrabPos;
    bool mHoveringOnSource{ false };
@@ -58,6 +58,13 @@ PatchCableSource::~PatchCableSource()
       delete cable;
 }
 
+void PatchCableSource::SetOverrideVizBuffer(RollingBuffer* viz)
+{
+   mOverrideVizBuffer = viz;
+   if (viz != nullptr)
+      viz->SetWriteOnlyWhenViewed(true); //these are only ever read to draw our cables
+}
+
 void PatchCableSource::SetConnectionType(ConnectionType type)
 {
    mType = type;
@@ -599,6 +606,26 @@ int PatchCableSource::GetHoverIndex(float x, float y) const
    return -1;
 }
 
+//area that GetHoverIndex() can report a hover in
+ofRectangle PatchCableSource::GetHoverBounds() const
+{
+   int count = MAX(1, (int)mPatchCables.size());
+   if (mDefaultPatchBehavior == kDefaultPatchBehavior_Add)
+      count = 1;
+   float extent = (count - 1) * kPatchCableSpacing;
+
+   ofRectangle bounds(mX, mY, 0, 0);
+   if (mSide == Side::kBottom)
+      bounds.height = extent;
+   else if (mSide == Side::kLeft)
+      bounds.set(mX - extent, mY, extent, 0);
+   else
+      bounds.width = extent;
+
+   bounds.grow(kPatchCableSourceClickRadius);
+   return bounds;
+}
+
 bool PatchCableSource::Enabled() const
 {
    return mEnabled;
@@ -94,7 +94,7 @@ public:
    ConnectionType GetConnectionType() const { return mType; }
    void SetConnectionType(ConnectionType type);
    IDrawableModule* GetOwner() const { return mOwner; }
-   void SetOverrideVizBuffer(RollingBuffer* viz) { mOverrideVizBuffer = viz; }
+   void SetOverrideVizBuffer(RollingBuffer* viz);
    RollingBuffer* GetOverrideVizBuffer() const { return mOverrideVizBuffer; }
    void UpdatePosition(bool parentMinimized);
    void SetManualPosition(int x, int y)
@@ -123,6 +123,7 @@ public:
    ofColor GetColor() const;
    void SetEnabled(bool enabled) { mEnabled = enabled; }
    bool Enabled() const;
+   ofRectangle GetHoverBounds() const;
    void AddTypeFilter(std::string type) { mTypeFilter.push_back(type); }
    void ClearTypeFilter() { mTypeFilter.clear(); }
    void SetPredicateFilter(bool (*predicate)(IClickable*)) { mFilterPredicate = predicate; }
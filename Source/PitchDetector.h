@@ -34,6 +34,7 @@ public:
    ~PitchDetector();
 
    float DetectPitch(float* buffer, int bufferSize);
+   float GetConfidence() const { return mConfidence; } //of the last analysis frame, voiced above .7
 
 private:
    ////////////////////////////////////////
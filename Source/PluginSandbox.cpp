@@ -0,0 +1,837 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    PluginSandbox.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "PluginSandbox.h"
+#include "ModularSynth.h"
+
+#include <thread>
+
+namespace PluginSandbox
+{
+   const uint32_t kMagic = 0x42535342; //"BSSB"
+   const int kMaxChannels = 32;
+   const int kMaxBlockSize = 4096;
+   const int kMaxMidiBytes = 16384;
+   const int kMaxParameterChanges = 256;
+
+   const int kLoadTimeoutMs = 30000;
+   const int kRequestTimeoutMs = 5000;
+
+   enum class Command : int
+   {
+      Load,
+      Prepare,
+      Release,
+      GetState,
+      SetState
+   };
+
+   //a block belongs to the host while it's free or holds output, and to the worker while it holds input or is being processed
+   enum BlockState : int32_t
+   {
+      kBlockFree,
+      kBlockInputReady,
+      kBlockProcessing,
+      kBlockOutputReady
+   };
+
+   struct ParameterChange
+   {
+      int32_t index;
+      float value;
+   };
+
+   struct TransportInfo
+   {
+      int32_t hasPosition;
+      int32_t isPlaying;
+      double bpm;
+      double ppqPosition;
+      double ppqPositionOfLastBarStart;
+      int64_t timeInSamples;
+      int32_t timeSigNumerator;
+      int32_t timeSigDenominator;
+   };
+
+   struct Block
+   {
+      std::atomic<int32_t> state;
+      uint32_t sequence;
+      int32_t numSamples;
+      int32_t numChannels;
+      TransportInfo transport;
+      int32_t numParameterChanges;
+      ParameterChange parameterChanges[kMaxParameterChanges];
+      int32_t numMidiBytes; //midi in on the way there, midi out on the way back
+      uint8_t midi[kMaxMidiBytes];
+      float audio[kMaxChannels][kMaxBlockSize];
+   };
+
+   struct SharedState
+   {
+      uint32_t magic;
+      uint32_t size;
+      std::atomic<int32_t> pluginLatency;
+      Block blocks[2];
+   };
+
+   static_assert(std::atomic<int32_t>::is_always_lock_free, "shared memory handoff needs lock-free atomics");
+
+   bool CreateSharedFile(const juce::File& file)
+   {
+      if (!file.create())
+         return false;
+      juce::FileOutputStream stream(file);
+      if (stream.failedToOpen())
+         return false;
+      stream.setPosition(0);
+      stream.truncate();
+      std::vector<char> zeros(65536);
+      for (size_t written = 0; written < sizeof(SharedState); written += zeros.size())
+         stream.write(zeros.data(), std::min(zeros.size(), sizeof(SharedState) - written));
+      stream.flush();
+      return stream.getStatus().wasOk();
+   }
+
+   SharedState* MapSharedFile(const juce::File& file, std::unique_ptr<juce::MemoryMappedFile>& mapping)
+   {
+      mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readWrite);
+      if (mapping->getData() == nullptr || mapping->getSize() < sizeof(SharedState))
+      {
+         mapping.reset();
+         return nullptr;
+      }
+      return static_cast<SharedState*>(mapping->getData());
+   }
+
+   int WriteMidi(const juce::MidiBuffer& midi, uint8_t* dest, int maxBytes)
+   {
+      int pos = 0;
+      for (const auto metadata : midi)
+      {
+         int32_t samplePosition = metadata.samplePosition;
+         int32_t numBytes = metadata.numBytes;
+         if (pos + (int)sizeof(int32_t) * 2 + numBytes > maxBytes)
+            break; //out of room, drop the rest
+         memcpy(dest + pos, &samplePosition, sizeof(int32_t));
+         pos += sizeof(int32_t);
+         memcpy(dest + pos, &numBytes, sizeof(int32_t));
+         pos += sizeof(int32_t);
+         memcpy(dest + pos, metadata.data, numBytes);
+         pos += numBytes;
+      }
+      return pos;
+   }
+
+   void ReadMidi(const uint8_t* src, int numBytes, juce::MidiBuffer& midi)
+   {
+      int pos = 0;
+      while (pos + (int)sizeof(int32_t) * 2 <= numBytes)
+      {
+         int32_t samplePosition;
+         int32_t messageBytes;
+         memcpy(&samplePosition, src + pos, sizeof(int32_t));
+         pos += sizeof(int32_t);
+         memcpy(&messageBytes, src + pos, sizeof(int32_t));
+         pos += sizeof(int32_t);
+         if (messageBytes <= 0 || pos + messageBytes > numBytes)
+            break;
+         midi.addEvent(src + pos, messageBytes, samplePosition);
+         pos += messageBytes;
+      }
+   }
+
+   juce::MemoryBlock MakeRequest(Command command)
+   {
+      juce::MemoryBlock block;
+      juce::MemoryOutputStream stream(block, false);
+      stream.writeInt((int)command);
+      return block;
+   }
+}
+
+using namespace PluginSandbox;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SandboxedPluginInstance::Coordinator : public juce::ChildProcessCoordinator
+{
+public:
+   bool Launch()
+   {
+      mConnected = launchWorkerProcess(juce::File::getSpecialLocation(juce::File::currentExecutableFile), kSandboxProcessUID, 0, 0);
+      return mConnected;
+   }
+
+   bool IsConnected() const { return mConnected; }
+
+   //one request at a time, blocking until the worker replies
+   bool SendRequest(const juce::MemoryBlock& request, juce::MemoryBlock& reply, int timeoutMs)
+   {
+      const std::lock_guard<std::mutex> requestLock(mRequestMutex);
+
+      if (!mConnected)
+         return false;
+
+      {
+         const std::lock_guard<std::mutex> lock(mMutex);
+         mGotReply = false;
+      }
+
+      if (!sendMessageToWorker(request))
+         return false;
+
+      std::unique_lock<std::mutex> lock(mMutex);
+      if (!mCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]
+                               {
+                                  return mGotReply || !mConnected;
+                               }))
+         return false;
+
+      if (!mConnected)
+         return false;
+
+      reply = std::move(mReply);
+      return true;
+   }
+
+private:
+   void handleMessageFromWorker(const juce::MemoryBlock& mb) override
+   {
+      const std::lock_guard<std::mutex> lock(mMutex);
+      mReply = mb;
+      mGotReply = true;
+      mCondition.notify_one();
+   }
+
+   void handleConnectionLost() override
+   {
+      const std::lock_guard<std::mutex> lock(mMutex);
+      mConnected = false;
+      mCondition.notify_one();
+   }
+
+   std::atomic<bool> mConnected{ false };
+   std::mutex mRequestMutex;
+   std::mutex mMutex;
+   std::condition_variable mCondition;
+   juce::MemoryBlock mReply;
+   bool mGotReply{ false };
+};
+
+class SandboxedPluginInstance::RemoteParameter : public juce::HostedAudioProcessorParameter
+{
+public:
+   RemoteParameter(SandboxedPluginInstance& owner, const juce::XmlElement& xml)
+   : mOwner(owner)
+   , mID(xml.getStringAttribute("id"))
+   , mName(xml.getStringAttribute("name"))
+   , mLabel(xml.getStringAttribute("label"))
+   , mDefaultValue((float)xml.getDoubleAttribute("default"))
+   , mNumSteps(xml.getIntAttribute("steps", juce::AudioProcessor::getDefaultNumParameterSteps()))
+   , mDiscrete(xml.getBoolAttribute("discrete"))
+   , mBoolean(xml.getBoolAttribute("boolean"))
+   , mValue((float)xml.getDoubleAttribute("value"))
+   {
+   }
+
+   float getValue() const override { return mValue; }
+   void setValue(float newValue) override
+   {
+      mValue = newValue;
+      if (!mDirty.exchange(true))
+         ++mOwner.mNumDirtyParameters;
+   }
+   float getDefaultValue() const override { return mDefaultValue; }
+   juce::String getName(int maximumStringLength) const override { return mName.substring(0, maximumStringLength); }
+   juce::String getLabel() const override { return mLabel; }
+   int getNumSteps() const override { return mNumSteps; }
+   bool isDiscrete() const override { return mDiscrete; }
+   bool isBoolean() const override { return mBoolean; }
+   //the plugin's own value formatting lives in the other process
+   juce::String getText(float value, int maximumStringLength) const override { return juce::String(value, 3).substring(0, maximumStringLength); }
+   float getValueForText(const juce::String& text) const override { return text.getFloatValue(); }
+   juce::String getParameterID() const override { return mID; }
+
+   void SetValueFromWorker(float value) { mValue = value; }
+   bool TakeDirty() { return mDirty.exchange(false); }
+
+private:
+   SandboxedPluginInstance& mOwner;
+   juce::String mID;
+   juce::String mName;
+   juce::String mLabel;
+   float mDefaultValue{ 0 };
+   int mNumSteps{ 0 };
+   bool mDiscrete{ false };
+   bool mBoolean{ false };
+   std::atomic<float> mValue{ 0 };
+   std::atomic<bool> mDirty{ false };
+};
+
+//static
+std::unique_ptr<SandboxedPluginInstance> SandboxedPluginInstance::Create(const juce::PluginDescription& desc, double sampleRate, int blockSize, juce::String& errorMessage)
+{
+   if (blockSize > kMaxBlockSize)
+   {
+      errorMessage = "buffer size is too large to sandbox plugins (max " + juce::String(kMaxBlockSize) + ")";
+      return nullptr;
+   }
+
+   auto coordinator = std::make_unique<Coordinator>();
+   if (!coordinator->Launch())
+   {
+      errorMessage = "couldn't launch plugin sandbox process";
+      return nullptr;
+   }
+
+   juce::File sharedFile = juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile("bespoke_sandbox", ".shm");
+   std::unique_ptr<juce::MemoryMappedFile> sharedMemory;
+   SharedState* shared = nullptr;
+   if (CreateSharedFile(sharedFile))
+      shared = MapSharedFile(sharedFile, sharedMemory);
+   if (shared == nullptr)
+   {
+      sharedFile.deleteFile();
+      errorMessage = "couldn't create shared memory for plugin sandbox";
+      return nullptr;
+   }
+   new (shared) SharedState();
+   shared->magic = kMagic;
+   shared->size = sizeof(SharedState);
+
+   juce::MemoryBlock request = MakeRequest(Command::Load);
+   {
+      juce::MemoryOutputStream stream(request, true);
+      stream.writeString(desc.createXml()->toString());
+      stream.writeDouble(sampleRate);
+      stream.writeInt(blockSize);
+      stream.writeString(sharedFile.getFullPathName());
+   }
+
+   juce::MemoryBlock reply;
+   std::unique_ptr<juce::XmlElement> info;
+   if (coordinator->SendRequest(request, reply, kLoadTimeoutMs))
+   {
+      juce::MemoryInputStream stream(reply, false);
+      if (stream.readBool())
+         info = juce::parseXML(stream.readString());
+      else
+         errorMessage = stream.readString();
+   }
+   else
+   {
+      errorMessage = coordinator->IsConnected() ? "plugin sandbox timed out loading plugin" : "plugin sandbox crashed loading plugin";
+   }
+
+   if (info == nullptr)
+   {
+      coordinator.reset();
+      sharedMemory.reset();
+      sharedFile.deleteFile();
+      if (errorMessage.isEmpty())
+         errorMessage = "plugin sandbox sent an invalid reply";
+      return nullptr;
+   }
+
+   BusesProperties buses;
+   for (auto* bus : info->getChildWithTagNameIterator("BUS"))
+   {
+      int numChannels = bus->getIntAttribute("channels");
+      buses.addBus(bus->getBoolAttribute("input"), bus->getStringAttribute("name"), numChannels > 0 ? juce::AudioChannelSet::canonicalChannelSet(numChannels) : juce::AudioChannelSet::disabled(), bus->getBoolAttribute("enabled"));
+   }
+
+   std::unique_ptr<SandboxedPluginInstance> instance(new SandboxedPluginInstance(desc, buses));
+   instance->mName = info->getStringAttribute("name");
+   instance->mAcceptsMidi = info->getBoolAttribute("acceptsMidi");
+   instance->mProducesMidi = info->getBoolAttribute("producesMidi");
+   instance->mTailLengthSeconds = info->getDoubleAttribute("tail");
+   instance->mBlockSize = blockSize;
+   instance->mCoordinator = std::move(coordinator);
+   instance->mSharedFile = sharedFile;
+   instance->mSharedMemory = std::move(sharedMemory);
+   instance->mShared = shared;
+   shared->pluginLatency = info->getIntAttribute("latency");
+
+   for (auto* parameterXml : info->getChildWithTagNameIterator("PARAM"))
+   {
+      auto* parameter = new RemoteParameter(*instance, *parameterXml);
+      instance->mRemoteParameters.push_back(parameter);
+      instance->addParameter(parameter);
+   }
+
+   instance->UpdateLatency();
+   instance->startTimer(500);
+   return instance;
+}
+
+SandboxedPluginInstance::SandboxedPluginInstance(const juce::PluginDescription& desc, const BusesProperties& buses)
+: juce::AudioPluginInstance(buses)
+, mDescription(desc)
+{
+}
+
+SandboxedPluginInstance::~SandboxedPluginInstance()
+{
+   stopTimer();
+   mCoordinator.reset(); //takes the worker down with it
+   mShared = nullptr;
+   mSharedMemory.reset();
+   mSharedFile.deleteFile();
+}
+
+bool SandboxedPluginInstance::IsWorkerAlive() const
+{
+   return mCoordinator != nullptr && mCoordinator->IsConnected();
+}
+
+void SandboxedPluginInstance::prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock)
+{
+   mBlockSize = maximumExpectedSamplesPerBlock;
+
+   juce::MemoryBlock request = MakeRequest(Command::Prepare);
+   {
+      juce::MemoryOutputStream stream(request, true);
+      stream.writeDouble(sampleRate);
+      stream.writeInt(maximumExpectedSamplesPerBlock);
+   }
+   juce::MemoryBlock reply;
+   mCoordinator->SendRequest(request, reply, kRequestTimeoutMs);
+
+   UpdateLatency();
+}
+
+void SandboxedPluginInstance::releaseResources()
+{
+   juce::MemoryBlock reply;
+   mCoordinator->SendRequest(MakeRequest(Command::Release), reply, kRequestTimeoutMs);
+}
+
+void SandboxedPluginInstance::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+   int numSamples = buffer.getNumSamples();
+   int numChannels = std::min(buffer.getNumChannels(), kMaxChannels);
+   if (!mCoordinator->IsConnected() || numSamples > kMaxBlockSize)
+   {
+      buffer.clear();
+      midiMessages.clear();
+      return;
+   }
+
+   //hand this buffer's input to the worker
+   Block& input = mShared->blocks[mBlockSequence % 2];
+   int32_t inputState = input.state.load(std::memory_order_acquire);
+   if (inputState == kBlockFree || inputState == kBlockOutputReady) //stale output that we never collected can be overwritten
+   {
+      input.sequence = mBlockSequence;
+      input.numSamples = numSamples;
+      input.numChannels = numChannels;
+      for (int ch = 0; ch < numChannels; ++ch)
+         juce::FloatVectorOperations::copy(input.audio[ch], buffer.getReadPointer(ch), numSamples);
+      input.numMidiBytes = WriteMidi(midiMessages, input.midi, kMaxMidiBytes);
+
+      input.numParameterChanges = 0;
+      if (mNumDirtyParameters > 0)
+      {
+         for (size_t i = 0; i < mRemoteParameters.size() && input.numParameterChanges < kMaxParameterChanges; ++i)
+         {
+            if (mRemoteParameters[i]->TakeDirty())
+            {
+               --mNumDirtyParameters;
+               input.parameterChanges[input.numParameterChanges].index = (int32_t)i;
+               input.parameterChanges[input.numParameterChanges].value = mRemoteParameters[i]->getValue();
+               ++input.numParameterChanges;
+            }
+         }
+      }
+
+      TransportInfo& transport = input.transport;
+      transport.hasPosition = 0;
+      if (auto* playHead = getPlayHead())
+      {
+         if (auto position = playHead->getPosition())
+         {
+            transport.hasPosition = 1;
+            transport.isPlaying = position->getIsPlaying() ? 1 : 0;
+            transport.bpm = position->getBpm().orFallback(120);
+            transport.ppqPosition = position->getPpqPosition().orFallback(0);
+            transport.ppqPositionOfLastBarStart = position->getPpqPositionOfLastBarStart().orFallback(0);
+            transport.timeInSamples = position->getTimeInSamples().orFallback(0);
+            auto timeSig = position->getTimeSignature().orFallback(juce::AudioPlayHead::TimeSignature());
+            transport.timeSigNumerator = timeSig.numerator;
+            transport.timeSigDenominator = timeSig.denominator;
+         }
+      }
+
+      input.state.store(kBlockInputReady, std::memory_order_release);
+   }
+   else
+   {
+      ++mNumDroppedBlocks; //worker is still busy with the block from two buffers ago
+   }
+
+   //and take the output of the previous buffer, if the worker finished it in time
+   Block& output = mShared->blocks[(mBlockSequence + 1) % 2];
+   if (output.state.load(std::memory_order_acquire) == kBlockOutputReady && output.sequence == mBlockSequence - 1)
+   {
+      int outputChannels = std::min(numChannels, (int)output.numChannels);
+      int outputSamples = std::min(numSamples, (int)output.numSamples);
+      for (int ch = 0; ch < outputChannels; ++ch)
+         juce::FloatVectorOperations::copy(buffer.getWritePointer(ch), output.audio[ch], outputSamples);
+      for (int ch = outputChannels; ch < buffer.getNumChannels(); ++ch)
+         buffer.clear(ch, 0, numSamples);
+      if (outputSamples < numSamples)
+         buffer.clear(0, outputSamples, numSamples - outputSamples);
+
+      midiMessages.clear();
+      ReadMidi(output.midi, output.numMidiBytes, midiMessages);
+
+      output.state.store(kBlockFree, std::memory_order_release);
+   }
+   else
+   {
+      buffer.clear();
+      midiMessages.clear();
+   }
+
+   ++mBlockSequence;
+}
+
+void SandboxedPluginInstance::getStateInformation(juce::MemoryBlock& destData)
+{
+   juce::MemoryBlock reply;
+   if (mCoordinator->SendRequest(MakeRequest(Command::GetState), reply, kRequestTimeoutMs))
+      destData = std::move(reply);
+}
+
+void SandboxedPluginInstance::setStateInformation(const void* data, int sizeInBytes)
+{
+   juce::MemoryBlock request = MakeRequest(Command::SetState);
+   request.append(data, sizeInBytes);
+
+   juce::MemoryBlock reply;
+   if (mCoordinator->SendRequest(request, reply, kRequestTimeoutMs))
+   {
+      juce::MemoryInputStream stream(reply, false);
+      ReadParameterValues(stream);
+   }
+}
+
+void SandboxedPluginInstance::ReadParameterValues(juce::MemoryInputStream& stream)
+{
+   int numParameters = stream.readInt();
+   for (int i = 0; i < numParameters && i < (int)mRemoteParameters.size(); ++i)
+      mRemoteParameters[i]->SetValueFromWorker(stream.readFloat());
+}
+
+void SandboxedPluginInstance::UpdateLatency()
+{
+   int latency = mBlockSize + mShared->pluginLatency.load();
+   if (latency != getLatencySamples())
+      setLatencySamples(latency);
+}
+
+void SandboxedPluginInstance::timerCallback()
+{
+   if (!IsWorkerAlive())
+   {
+      if (!mReportedCrash)
+      {
+         TheSynth->LogEvent("sandboxed plugin \"" + mName.toStdString() + "\" crashed, it will output silence until it's reloaded", kLogEventType_Error);
+         mReportedCrash = true;
+      }
+      return;
+   }
+
+   UpdateLatency();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+PluginSandboxSubprocess::PluginSandboxSubprocess()
+: juce::Thread("plugin sandbox audio")
+{
+#if JUCE_VERSION < ((8 << 16) + (0 << 8) + 11) // member-function replaced in 8.0.11
+   mFormatManager.addDefaultFormats();
+#else
+   juce::addDefaultFormatsToManager(mFormatManager);
+#endif
+}
+
+PluginSandboxSubprocess::~PluginSandboxSubprocess()
+{
+   stopThread(1000);
+   mPlugin.reset();
+   mShared = nullptr;
+   mSharedMemory.reset();
+}
+
+void PluginSandboxSubprocess::handleMessageFromCoordinator(const juce::MemoryBlock& mb)
+{
+   {
+      const std::lock_guard<std::mutex> lock(mMutex);
+      mPendingBlocks.emplace(mb);
+   }
+
+   triggerAsyncUpdate();
+}
+
+void PluginSandboxSubprocess::handleConnectionLost()
+{
+   juce::JUCEApplicationBase::quit();
+}
+
+void PluginSandboxSubprocess::handleAsyncUpdate()
+{
+   for (;;)
+   {
+      juce::MemoryBlock block;
+      {
+         const std::lock_guard<std::mutex> lock(mMutex);
+         if (mPendingBlocks.empty())
+            return;
+         block = std::move(mPendingBlocks.front());
+         mPendingBlocks.pop();
+      }
+
+      sendMessageToCoordinator(HandleRequest(block));
+   }
+}
+
+juce::MemoryBlock PluginSandboxSubprocess::HandleRequest(const juce::MemoryBlock& request)
+{
+   juce::MemoryInputStream stream(request, false);
+   Command command = (Command)stream.readInt();
+
+   juce::MemoryBlock reply;
+   juce::MemoryOutputStream replyStream(reply, false);
+
+   switch (command)
+   {
+      case Command::Load:
+      {
+         auto descXml = juce::parseXML(stream.readString());
+         double sampleRate = stream.readDouble();
+         int blockSize = stream.readInt();
+         juce::File sharedFile(stream.readString());
+
+         juce::String errorMessage;
+         juce::PluginDescription desc;
+         if (mPlugin != nullptr)
+            errorMessage = "sandbox already has a plugin loaded";
+         else if (descXml == nullptr || !desc.loadFromXml(*descXml))
+            errorMessage = "invalid plugin description";
+         else if ((mShared = MapSharedFile(sharedFile, mSharedMemory)) == nullptr || mShared->magic != kMagic || mShared->size != sizeof(SharedState))
+            errorMessage = "couldn't open plugin sandbox shared memory";
+         else
+            mPlugin = mFormatManager.createPluginInstance(desc, sampleRate, blockSize, errorMessage);
+
+         if (mPlugin == nullptr)
+         {
+            replyStream.writeBool(false);
+            replyStream.writeString(errorMessage);
+            break;
+         }
+
+         mPlugin->enableAllBuses();
+         mPlugin->prepareToPlay(sampleRate, blockSize);
+         mPlugin->setPlayHead(&mPlayHead);
+         mMidiBuffer.ensureSize(kMaxMidiBytes);
+
+         juce::XmlElement info("SANDBOX");
+         info.setAttribute("name", mPlugin->getName());
+         info.setAttribute("acceptsMidi", mPlugin->acceptsMidi());
+         info.setAttribute("producesMidi", mPlugin->producesMidi());
+         info.setAttribute("tail", mPlugin->getTailLengthSeconds());
+         info.setAttribute("latency", mPlugin->getLatencySamples());
+         for (bool isInput : { true, false })
+         {
+            for (int i = 0; i < mPlugin->getBusCount(isInput); ++i)
+            {
+               auto* bus = mPlugin->getBus(isInput, i);
+               auto* busXml = info.createNewChildElement("BUS");
+               busXml->setAttribute("input", isInput);
+               busXml->setAttribute("name", bus->getName());
+               busXml->setAttribute("channels", bus->getNumberOfChannels());
+               busXml->setAttribute("enabled", bus->isEnabled());
+            }
+         }
+         const auto& parameters = mPlugin->getParameters();
+         for (int i = 0; i < parameters.size(); ++i)
+         {
+            auto* parameter = parameters[i];
+            auto* parameterXml = info.createNewChildElement("PARAM");
+            auto* hosted = dynamic_cast<juce::HostedAudioProcessorParameter*>(parameter);
+            parameterXml->setAttribute("id", hosted != nullptr ? hosted->getParameterID() : juce::String(i));
+            parameterXml->setAttribute("name", parameter->getName(256));
+            parameterXml->setAttribute("label", parameter->getLabel());
+            parameterXml->setAttribute("default", parameter->getDefaultValue());
+            parameterXml->setAttribute("steps", parameter->getNumSteps());
+            parameterXml->setAttribute("discrete", parameter->isDiscrete());
+            parameterXml->setAttribute("boolean", parameter->isBoolean());
+            parameterXml->setAttribute("value", parameter->getValue());
+         }
+
+         replyStream.writeBool(true);
+         replyStream.writeString(info.toString());
+
+         startThread(juce::Thread::Priority::highest);
+         break;
+      }
+      case Command::Prepare:
+      {
+         double sampleRate = stream.readDouble();
+         int blockSize = stream.readInt();
+         if (mPlugin != nullptr)
+         {
+            mPlugin->suspendProcessing(true);
+            mPlugin->prepareToPlay(sampleRate, blockSize);
+            mPlugin->suspendProcessing(false);
+         }
+         replyStream.writeBool(true);
+         break;
+      }
+      case Command::Release:
+      {
+         if (mPlugin != nullptr)
+         {
+            mPlugin->suspendProcessing(true);
+            mPlugin->releaseResources();
+            mPlugin->suspendProcessing(false);
+         }
+         replyStream.writeBool(true);
+         break;
+      }
+      case Command::GetState:
+      {
+         if (mPlugin != nullptr)
+         {
+            juce::MemoryBlock state;
+            mPlugin->getStateInformation(state);
+            replyStream.write(state.getData(), state.getSize());
+         }
+         break;
+      }
+      case Command::SetState:
+      {
+         if (mPlugin != nullptr)
+         {
+            int stateSize = (int)(request.getSize() - stream.getPosition());
+            mPlugin->setStateInformation(static_cast<const char*>(request.getData()) + stream.getPosition(), stateSize);
+
+            //send back where the parameters ended up
+            const auto& parameters = mPlugin->getParameters();
+            replyStream.writeInt(parameters.size());
+            for (auto* parameter : parameters)
+               replyStream.writeFloat(parameter->getValue());
+         }
+         break;
+      }
+   }
+
+   replyStream.flush();
+   return reply;
+}
+
+void PluginSandboxSubprocess::run()
+{
+   //there's no cross-platform way to signal across processes, so poll: spin briefly after each block, then back off to sleeping
+   int idleCount = 0;
+   while (!threadShouldExit())
+   {
+      Block* block = nullptr;
+      for (auto& candidate : mShared->blocks)
+      {
+         if (candidate.state.load(std::memory_order_acquire) == kBlockInputReady && (block == nullptr || (int32_t)(candidate.sequence - block->sequence) < 0))
+            block = &candidate;
+      }
+
+      if (block == nullptr)
+      {
+         if (++idleCount < 2000)
+            std::this_thread::yield();
+         else
+            juce::Thread::sleep(1);
+         continue;
+      }
+      idleCount = 0;
+
+      int32_t expected = kBlockInputReady;
+      if (!block->state.compare_exchange_strong(expected, kBlockProcessing, std::memory_order_acq_rel))
+         continue;
+
+      int numSamples = juce::jlimit(0, kMaxBlockSize, (int)block->numSamples);
+      int numChannels = juce::jlimit(0, kMaxChannels, std::max((int)block->numChannels, std::max(mPlugin->getTotalNumInputChannels(), mPlugin->getTotalNumOutputChannels())));
+      for (int ch = block->numChannels; ch < numChannels; ++ch)
+         juce::FloatVectorOperations::clear(block->audio[ch], numSamples);
+
+      //process straight out of shared memory
+      float* channels[kMaxChannels];
+      for (int ch = 0; ch < numChannels; ++ch)
+         channels[ch] = block->audio[ch];
+      mBuffer.setDataToReferTo(channels, numChannels, numSamples);
+
+      mMidiBuffer.clear();
+      ReadMidi(block->midi, block->numMidiBytes, mMidiBuffer);
+
+      const auto& parameters = mPlugin->getParameters();
+      for (int i = 0; i < block->numParameterChanges && i < kMaxParameterChanges; ++i)
+      {
+         const ParameterChange& change = block->parameterChanges[i];
+         if (change.index >= 0 && change.index < parameters.size())
+            parameters[change.index]->setValue(change.value);
+      }
+
+      const TransportInfo& transport = block->transport;
+      mPlayHead.mPosition = juce::AudioPlayHead::PositionInfo();
+      if (transport.hasPosition)
+      {
+         mPlayHead.mPosition.setIsPlaying(transport.isPlaying != 0);
+         mPlayHead.mPosition.setBpm(transport.bpm);
+         mPlayHead.mPosition.setPpqPosition(transport.ppqPosition);
+         mPlayHead.mPosition.setPpqPositionOfLastBarStart(transport.ppqPositionOfLastBarStart);
+         mPlayHead.mPosition.setTimeInSamples(transport.timeInSamples);
+         juce::AudioPlayHead::TimeSignature timeSig;
+         timeSig.numerator = transport.timeSigNumerator;
+         timeSig.denominator = transport.timeSigDenominator;
+         mPlayHead.mPosition.setTimeSignature(timeSig);
+      }
+
+      {
+         const juce::ScopedLock lock(mPlugin->getCallbackLock());
+         if (mPlugin->isSuspended())
+            mBuffer.clear();
+         else
+            mPlugin->processBlock(mBuffer, mMidiBuffer);
+      }
+
+      block->numChannels = numChannels;
+      block->numMidiBytes = WriteMidi(mMidiBuffer, block->midi, kMaxMidiBytes);
+      mShared->pluginLatency.store(mPlugin->getLatencySamples());
+      block->state.store(kBlockOutputReady, std::memory_order_release);
+   }
+}
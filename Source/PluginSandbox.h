@@ -0,0 +1,145 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    PluginSandbox.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "juce_audio_processors/juce_audio_processors.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
+constexpr const char* kSandboxProcessUID = "bespokesynthsandbox";
+
+namespace PluginSandbox
+{
+   struct SharedState;
+}
+
+//host side of a plugin running in a separate worker process, so that a crashing or stalling plugin can't take down the whole session.
+//to VSTPlugin it looks like any other plugin instance. audio and midi cross through shared memory with one buffer of pipelining,
+//which is added to the reported latency so that delay compensation lines it back up. parameters and state cross over the same shared
+//memory and the child process connection.
+class SandboxedPluginInstance : public juce::AudioPluginInstance, private juce::Timer
+{
+public:
+   static std::unique_ptr<SandboxedPluginInstance> Create(const juce::PluginDescription& desc, double sampleRate, int blockSize, juce::String& errorMessage);
+   ~SandboxedPluginInstance() override;
+
+   bool IsWorkerAlive() const;
+
+   //juce::AudioPluginInstance
+   void fillInPluginDescription(juce::PluginDescription& description) const override { description = mDescription; }
+
+   //juce::AudioProcessor
+   const juce::String getName() const override { return mName; }
+   void prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock) override;
+   void releaseResources() override;
+   void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override;
+   double getTailLengthSeconds() const override { return mTailLengthSeconds; }
+   bool acceptsMidi() const override { return mAcceptsMidi; }
+   bool producesMidi() const override { return mProducesMidi; }
+   juce::AudioProcessorEditor* createEditor() override { return nullptr; } //the plugin's own editor lives in the other process
+   bool hasEditor() const override { return false; }
+   int getNumPrograms() override { return 1; }
+   int getCurrentProgram() override { return 0; }
+   void setCurrentProgram(int index) override {}
+   const juce::String getProgramName(int index) override { return {}; }
+   void changeProgramName(int index, const juce::String& newName) override {}
+   void getStateInformation(juce::MemoryBlock& destData) override;
+   void setStateInformation(const void* data, int sizeInBytes) override;
+
+private:
+   class Coordinator;
+   class RemoteParameter;
+
+   SandboxedPluginInstance(const juce::PluginDescription& desc, const BusesProperties& buses);
+   void ReadParameterValues(juce::MemoryInputStream& stream);
+   void UpdateLatency();
+
+   //juce::Timer
+   void timerCallback() override;
+
+   juce::PluginDescription mDescription;
+   juce::String mName;
+   bool mAcceptsMidi{ false };
+   bool mProducesMidi{ false };
+   double mTailLengthSeconds{ 0 };
+   int mBlockSize{ 0 };
+
+   std::unique_ptr<Coordinator> mCoordinator;
+   juce::File mSharedFile;
+   std::unique_ptr<juce::MemoryMappedFile> mSharedMemory;
+   PluginSandbox::SharedState* mShared{ nullptr };
+   uint32_t mBlockSequence{ 0 };
+   std::vector<RemoteParameter*> mRemoteParameters;
+   std::atomic<int> mNumDirtyParameters{ 0 };
+   int mNumDroppedBlocks{ 0 };
+   bool mReportedCrash{ false };
+};
+
+//worker side, launched by SandboxedPluginInstance with kSandboxProcessUID on the command line. hosts a single plugin and runs its own audio thread.
+class PluginSandboxSubprocess : private juce::ChildProcessWorker,
+                                private juce::AsyncUpdater,
+                                private juce::Thread
+{
+public:
+   PluginSandboxSubprocess();
+   ~PluginSandboxSubprocess() override;
+
+   using juce::ChildProcessWorker::initialiseFromCommandLine;
+
+private:
+   class PlayHead : public juce::AudioPlayHead
+   {
+   public:
+      juce::Optional<PositionInfo> getPosition() const override { return mPosition; }
+      PositionInfo mPosition;
+   };
+
+   void handleMessageFromCoordinator(const juce::MemoryBlock& mb) override;
+   void handleConnectionLost() override;
+
+   //requests are handled on the main thread, like plugin scanning
+   void handleAsyncUpdate() override;
+   juce::MemoryBlock HandleRequest(const juce::MemoryBlock& request);
+
+   //juce::Thread
+   void run() override;
+
+   juce::AudioPluginFormatManager mFormatManager;
+   std::unique_ptr<juce::AudioPluginInstance> mPlugin;
+   std::unique_ptr<juce::MemoryMappedFile> mSharedMemory;
+   PluginSandbox::SharedState* mShared{ nullptr };
+   PlayHead mPlayHead;
+   juce::AudioBuffer<float> mBuffer;
+   juce::MidiBuffer mMidiBuffer;
+
+   std::mutex mMutex;
+   std::queue<juce::MemoryBlock> mPendingBlocks;
+};
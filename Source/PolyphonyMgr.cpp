@@ -27,8 +27,7 @@
 #include "IMidiVoice.h"
 #include "SynthGlobals.h"
 #include "Profiler.h"
-
-ChannelBuffer gMidiVoiceWorkChannelBuffer(kWorkBufferSize);
+#include "ModularSynth.h"
 
 PolyphonyMgr::PolyphonyMgr(IDrawableModule* owner)
 : mOwner(owner)
@@ -91,14 +90,18 @@ int PolyphonyMgr::Start(double time, int pitch, float amount, int voiceIdx, Modu
    if (!voice.IsDone(time) && (!preserveVoice || modulation.pan != voice.GetPan()))
    {
       //ofLog() << "fading stolen voice " << voiceIdx << " at " << time;
+      //the fade buffers run at the oversampled rate, so the fade goes through the downsampling filter with everything else
+      const int fadeLength = mFadeOutBuffer.BufferSize();
       mFadeOutWorkBuffer.Clear();
+      voice.UpdateModulationBlocks();
       voice.Process(time, &mFadeOutWorkBuffer, mOversampling);
-      for (int i = 0; i < kVoiceFadeSamples; ++i)
+      for (int i = 0; i < fadeLength; ++i)
       {
-         float fade = 1 - (float(i) / kVoiceFadeSamples);
+         float fade = 1 - (float(i) / fadeLength);
          for (int ch = 0; ch < mFadeOutBuffer.NumActiveChannels(); ++ch)
-            mFadeOutBuffer.GetChannel(ch)[(i + mFadeOutBufferPos) % kVoiceFadeSamples] += mFadeOutWorkBuffer.GetChannel(ch)[i] * fade;
+            mFadeOutBuffer.GetChannel(ch)[(i + mFadeOutBufferPos) % fadeLength] += mFadeOutWorkBuffer.GetChannel(ch)[i] * fade;
       }
+      mFadeOutSamplesPending = kVoiceFadeSamples;
    }
    if (!preserveVoice)
       voice.ClearVoice();
@@ -145,21 +148,57 @@ void PolyphonyMgr::KillAll()
    }
 }
 
+void PolyphonyMgr::SetOversampling(int oversampling)
+{
+   if (oversampling == mOversampling)
+      return;
+
+   //this reallocates the buffers and filters, so it happens here rather than on the audio thread, which just waits for it
+   ScopedMutex mutex(TheSynth->GetAudioMutex(), "PolyphonyMgr::SetOversampling()");
+   mFadeOutBuffer.Resize(kVoiceFadeSamples * oversampling);
+   mFadeOutWorkBuffer.Resize(kVoiceFadeSamples * oversampling);
+   mFadeOutBufferPos = 0;
+   mFadeOutSamplesPending = 0;
+   if (oversampling > 1)
+   {
+      mOversampledBuffer.Resize(gBufferSize * oversampling);
+      for (auto& downsampler : mDownsamplers)
+         downsampler.Setup(oversampling, gBufferSize);
+   }
+   mOversampling = oversampling;
+}
+
 void PolyphonyMgr::Process(double time, ChannelBuffer* out, int bufferSize)
 {
    PROFILER(PolyphonyMgr);
 
+   const int oversampling = mOversampling;
+   assert(oversampling == 1 || mOversampledBuffer.BufferSize() >= bufferSize * oversampling);
+
+   ChannelBuffer* voiceOut = out;
+   if (oversampling > 1)
+   {
+      voiceOut = &mOversampledBuffer;
+      voiceOut->SetNumActiveChannels(out->NumActiveChannels());
+      voiceOut->Clear();
+   }
+   const int numSamples = bufferSize * oversampling;
+   const int fadeLength = mFadeOutBuffer.BufferSize();
+
    mFadeOutBuffer.SetNumActiveChannels(out->NumActiveChannels());
    mFadeOutWorkBuffer.SetNumActiveChannels(out->NumActiveChannels());
 
+   bool anyVoicePlaying = false;
    float debugRef = 0;
    for (int i = 0; i < mVoiceLimit; ++i)
    {
       if (mVoices[i].mPitch != -1)
       {
-         mVoices[i].mVoice->Process(time, out, mOversampling);
+         anyVoicePlaying = true;
+         mVoices[i].mVoice->UpdateModulationBlocks();
+         mVoices[i].mVoice->Process(time, voiceOut, oversampling);
 
-         float testSample = out->GetChannel(0)[0];
+         float testSample = voiceOut->GetChannel(0)[0];
          mVoices[i].mActivity = testSample - debugRef;
 
          if (!mVoices[i].mNoteOn && mVoices[i].mVoice->IsDone(time))
@@ -171,15 +210,44 @@ void PolyphonyMgr::Process(double time, ChannelBuffer* out, int bufferSize)
 
    for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
    {
-      for (int i = 0; i < bufferSize; ++i)
+      for (int i = 0; i < numSamples; ++i)
       {
-         int fadeOutIdx = (i + mFadeOutBufferPos) % kVoiceFadeSamples;
-         out->GetChannel(ch)[i] += mFadeOutBuffer.GetChannel(ch)[fadeOutIdx];
+         int fadeOutIdx = (i + mFadeOutBufferPos) % fadeLength;
+         voiceOut->GetChannel(ch)[i] += mFadeOutBuffer.GetChannel(ch)[fadeOutIdx];
          mFadeOutBuffer.GetChannel(ch)[fadeOutIdx] = 0;
       }
    }
 
-   mFadeOutBufferPos += bufferSize;
+   mFadeOutBufferPos = (mFadeOutBufferPos + numSamples) % fadeLength;
+
+   if (oversampling > 1)
+   {
+      for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
+      {
+         mDownsamplers[ch].Downsample(voiceOut->GetChannel(ch), gWorkBuffer, bufferSize);
+         Add(out->GetChannel(ch), gWorkBuffer, bufferSize);
+      }
+
+      //keep running until the filter has let go of the last voice's output
+      if (anyVoicePlaying || mFadeOutSamplesPending > 0)
+         mDownsamplerTailPending = mDownsamplers[0].GetLatencySamples() * 2;
+      else
+         mDownsamplerTailPending = MAX(0, mDownsamplerTailPending - bufferSize);
+   }
+
+   mFadeOutSamplesPending = MAX(0, mFadeOutSamplesPending - bufferSize);
+}
+
+bool PolyphonyMgr::IsIdle() const
+{
+   if (mFadeOutSamplesPending > 0 || mDownsamplerTailPending > 0)
+      return false;
+   for (int i = 0; i < mVoiceLimit; ++i)
+   {
+      if (mVoices[i].mPitch != -1)
+         return false;
+   }
+   return true;
 }
 
 void PolyphonyMgr::DrawDebug(float x, float y)
@@ -29,11 +29,10 @@
 #include <functional>
 #include "SynthGlobals.h"
 #include "ChannelBuffer.h"
+#include "Oversampler.h"
 
 const int kVoiceFadeSamples = 50;
 
-extern ChannelBuffer gMidiVoiceWorkChannelBuffer;
-
 class IMidiVoice;
 class IVoiceParams;
 class IDrawableModule;
@@ -64,8 +63,9 @@ public:
    void DrawDebug(float x, float y);
    void SetVoiceLimit(int limit) { mVoiceLimit = limit; }
    void KillAll();
-   void SetOversampling(int oversampling) { mOversampling = oversampling; }
+   void SetOversampling(int oversampling); //voices are then given a buffer this many times longer to render into, which we filter back down
    const VoiceInfo& GetVoiceInfo(int voiceIdx) const { return mVoices[voiceIdx]; }
+   bool IsIdle() const; //no voices playing and no stolen voices still fading out
 
 private:
    VoiceInfo mVoices[kNumVoices];
@@ -74,7 +74,11 @@ private:
    ChannelBuffer mFadeOutBuffer{ kVoiceFadeSamples };
    ChannelBuffer mFadeOutWorkBuffer{ kVoiceFadeSamples };
    int mFadeOutBufferPos{ 0 };
+   int mFadeOutSamplesPending{ 0 };
    IDrawableModule* mOwner;
    int mVoiceLimit{ kNumVoices };
-   int mOversampling{ 1 };
+   int mOversampling{ 1 }; //what the buffers below are set up for
+   ChannelBuffer mOversampledBuffer{ 1 };
+   Oversampler mDownsamplers[ChannelBuffer::kMaxNumChannels]{};
+   int mDownsamplerTailPending{ 0 };
 };
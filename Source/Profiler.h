@@ -44,6 +44,7 @@ public:
    static void Draw();
 
    static void ToggleProfiler();
+   static bool IsEnabled() { return sEnableProfiler; }
 
 private:
    static long GetSafeFrameLengthNanoseconds();
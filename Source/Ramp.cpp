@@ -74,6 +74,18 @@ float Ramp::Value(double time) const
    return retVal;
 }
 
+bool Ramp::IsConstantBetween(double startTime, double endTime) const
+{
+   for (const auto& rampData : mRampDatas)
+   {
+      if (rampData.mStartTime >= startTime && rampData.mStartTime < endTime)
+         return false; //a new ramp takes over partway through
+   }
+
+   const RampData* rampData = GetCurrentRampData(startTime);
+   return rampData->mStartTime == -1 || rampData->mEndTime <= startTime || rampData->mStartValue == rampData->mEndValue;
+}
+
 const Ramp::RampData* Ramp::GetCurrentRampData(double time) const
 {
    int ret = 0;
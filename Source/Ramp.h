@@ -36,6 +36,7 @@ public:
    bool HasValue(double time) const;
    float Value(double time) const;
    float Target(double time) const { return GetCurrentRampData(time)->mEndValue; }
+   bool IsConstantBetween(double startTime, double endTime) const;
 
 private:
    struct RampData
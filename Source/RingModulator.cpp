@@ -97,11 +97,10 @@ void RingModulator::Process(double time)
          Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), GetBuffer()->BufferSize());
       }
 
-      Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize());
       GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void RingModulator::DrawModule()
@@ -49,6 +49,7 @@ public:
 
    //IAudioSource
    void Process(double time) override;
+   float GetTailLengthMs() override { return 0; }
 
    //INoteReceiver
    void PlayNote(NoteMessage note) override;
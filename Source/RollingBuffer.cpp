@@ -27,6 +27,8 @@
 #include "SynthGlobals.h"
 #include "UserPrefs.h"
 
+#include <algorithm>
+
 RollingBuffer::RollingBuffer(int sizeInSamples)
 : mBuffer(sizeInSamples)
 {
@@ -36,10 +38,16 @@ RollingBuffer::~RollingBuffer()
 {
 }
 
+namespace
+{
+   const double kViewTimeoutMs = 500;
+}
+
 float RollingBuffer::GetSample(int samplesAgo, int channel)
 {
    assert(samplesAgo >= 0);
    assert(samplesAgo < Size());
+   samplesAgo /= mDecimation;
    return mBuffer.GetChannel(channel)[(Size() + mOffsetToNow[channel] - samplesAgo) % Size()];
 }
 
@@ -47,6 +55,14 @@ void RollingBuffer::ReadChunk(float* dst, int size, int samplesAgo, int channel)
 {
    assert(size <= Size());
 
+   if (mDecimation > 1)
+   {
+      const float* data = mBuffer.GetChannel(channel);
+      for (int i = 0; i < size; ++i)
+         dst[i] = data[(Size() + mOffsetToNow[channel] - (samplesAgo + size - i) / mDecimation) % Size()];
+      return;
+   }
+
    int offset = mOffsetToNow[channel] - samplesAgo;
    if (offset < 0)
       offset += Size();
@@ -69,10 +85,73 @@ void RollingBuffer::Accum(int samplesAgo, float sample, int channel)
    mBuffer.GetChannel(channel)[(Size() + mOffsetToNow[channel] - samplesAgo) % Size()] += sample;
 }
 
+void RollingBuffer::MarkViewed(int numPointsNeeded /*= -1*/)
+{
+   mLastViewedTime = gTime;
+
+   int decimation = 1;
+   if (numPointsNeeded > 0)
+      decimation = std::clamp(Size() / numPointsNeeded, 1, kMaxDecimation);
+
+   //keep the finest resolution that any reader asked for
+   int requested = mRequestedDecimation.load();
+   while ((requested == 0 || decimation < requested) && !mRequestedDecimation.compare_exchange_weak(requested, decimation))
+   {
+   }
+}
+
+//called on the audio thread before each write. returns false if nobody is looking at us.
+bool RollingBuffer::PrepareWrite()
+{
+   if (!mWriteOnlyWhenViewed)
+      return true;
+
+   if (gTime - mLastViewedTime.load() > kViewTimeoutMs)
+   {
+      mStale = true;
+      return false;
+   }
+
+   if (gTime >= mDecimationWindowEnd)
+   {
+      //pick up the resolution that readers asked for over the last window
+      int requested = mRequestedDecimation.exchange(0);
+      mDecimationWindowEnd = gTime + kViewTimeoutMs;
+      if (requested != 0 && requested != mDecimation)
+      {
+         mDecimation = requested;
+         mStale = true;
+      }
+   }
+
+   if (mStale)
+   {
+      //whatever is in here is from before we went to sleep, or at a different resolution
+      ClearBuffer();
+      for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
+         mDecimationPhase[i] = 0;
+      mStale = false;
+   }
+
+   return true;
+}
+
 void RollingBuffer::WriteChunk(float* samples, int size, int channel)
 {
    assert(size < Size());
 
+   if (!PrepareWrite())
+      return;
+
+   if (mDecimation > 1)
+   {
+      int& phase = mDecimationPhase[channel];
+      for (int i = (mDecimation - phase) % mDecimation; i < size; i += mDecimation)
+         WriteSample(samples[i], channel);
+      phase = (phase + size) % mDecimation;
+      return;
+   }
+
    int wrapSamples = (mOffsetToNow[channel] + size) - Size();
    if (wrapSamples <= 0) //no wraparound
    {
@@ -90,6 +169,22 @@ void RollingBuffer::WriteChunk(float* samples, int size, int channel)
 }
 
 void RollingBuffer::Write(float sample, int channel)
+{
+   if (!PrepareWrite())
+      return;
+
+   if (mDecimation > 1)
+   {
+      int phase = mDecimationPhase[channel];
+      mDecimationPhase[channel] = (phase + 1) % mDecimation;
+      if (phase != 0)
+         return;
+   }
+
+   WriteSample(sample, channel);
+}
+
+void RollingBuffer::WriteSample(float sample, int channel)
 {
    mBuffer.GetChannel(channel)[mOffsetToNow[channel]] = sample;
    mOffsetToNow[channel] = (mOffsetToNow[channel] + 1) % Size();
@@ -111,6 +206,12 @@ void RollingBuffer::Draw(int x, int y, int width, int height, int length /*= -1*
 
    ofTranslate(x, y);
 
+   if (length != -1)
+   {
+      length /= mDecimation;
+      delayOffset /= mDecimation;
+   }
+
    if (length == -1) //draw full rolling buffer
    {
       if (channel == -1)
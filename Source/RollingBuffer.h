@@ -28,6 +28,8 @@
 #include "FileStream.h"
 #include "ChannelBuffer.h"
 
+#include <atomic>
+
 class RollingBuffer
 {
 public:
@@ -49,7 +51,23 @@ public:
    void SaveState(FileStreamOut& out);
    void LoadState(FileStreamIn& in);
 
+   //for visualization buffers: writes are dropped unless something has drawn the buffer recently, and are decimated down to the resolution it's drawn at
+   void SetWriteOnlyWhenViewed(bool onlyWhenViewed) { mWriteOnlyWhenViewed = onlyWhenViewed; }
+   void MarkViewed(int numPointsNeeded = -1); //call from drawing code before reading the buffer. -1 means every sample is needed.
+
 private:
+   bool PrepareWrite();
+   void WriteSample(float sample, int channel);
+
+   static constexpr int kMaxDecimation = 16;
+
    int mOffsetToNow[ChannelBuffer::kMaxNumChannels]{};
    ChannelBuffer mBuffer;
+   bool mWriteOnlyWhenViewed{ false };
+   std::atomic<double> mLastViewedTime{ -1 };
+   std::atomic<int> mRequestedDecimation{ 0 };
+   int mDecimation{ 1 };
+   int mDecimationPhase[ChannelBuffer::kMaxNumChannels]{};
+   double mDecimationWindowEnd{ 0 };
+   bool mStale{ true };
 };
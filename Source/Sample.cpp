@@ -29,6 +29,7 @@
 #include "ModularSynth.h"
 #include "ChannelBuffer.h"
 #include <memory>
+#include <thread>
 #include "UserPrefs.h"
 
 #include "juce_audio_formats/juce_audio_formats.h"
@@ -39,6 +40,7 @@ Sample::Sample()
 
 Sample::~Sample()
 {
+   CancelRead();
 }
 
 bool Sample::Read(const char* path, bool mono, ReadType readType)
@@ -49,36 +51,61 @@ bool Sample::Read(const char* path, bool mono, ReadType readType)
    mName = tokens[tokens.size() - 1];
 
    juce::File file(ofToSamplePath(mReadPath));
-   delete mReader;
-   mReader = TheSynth->GetAudioFormatManager().createReaderFor(file);
 
-   if (mReader != nullptr)
+   CancelRead(); //if we were still reading something else, forget about it
+
+   bool convert = UserPrefs.resample_samples_on_load.Get(); //to the session rate, so playback doesn't have to
+   mPoolKey = SamplePool::MakeKey(file, mono, convert ? gSampleRate : 0);
+   int pooledSampleRate = 0;
+   std::shared_ptr<ChannelBuffer> pooledData = SamplePool::Find(mPoolKey, pooledSampleRate);
+   if (pooledData != nullptr)
+   {
+      SetData(pooledData, true);
+      mOffset = mNumSamples;
+      mOriginalSampleRate = pooledSampleRate;
+      mSampleRateRatio = float(mOriginalSampleRate) / gSampleRate;
+      return true;
+   }
+
+   std::unique_ptr<juce::AudioFormatReader> reader(TheSynth->GetAudioFormatManager().createReaderFor(file)); //just for the format and length, SampleDecoder does the reading
+
+   juce::File cacheFile;
+   if (reader != nullptr && convert && (int)reader->sampleRate != gSampleRate)
    {
-      mData.Resize((int)mReader->lengthInSamples);
+      cacheFile = SampleResampler::GetCacheFile(mPoolKey);
+      std::unique_ptr<juce::AudioFormatReader> cachedReader(TheSynth->GetAudioFormatManager().createReaderFor(cacheFile));
+      if (cachedReader != nullptr && (int)cachedReader->sampleRate == gSampleRate) //converted in an earlier session
+      {
+         file = cacheFile;
+         reader = std::move(cachedReader);
+      }
+   }
+   convert = convert && reader != nullptr && (int)reader->sampleRate != gSampleRate;
+
+   if (reader != nullptr)
+   {
+      int fileLength = (int)reader->lengthInSamples;
+      int length = convert ? SampleResampler::GetOutputLength(fileLength, (int)reader->sampleRate, gSampleRate) : fileLength;
+      auto data = std::make_shared<ChannelBuffer>(length);
       if (mono)
-         mData.SetNumActiveChannels(1);
+         data->SetNumActiveChannels(1);
       else
-         mData.SetNumActiveChannels(mReader->numChannels);
-      mData.Clear();
+         data->SetNumActiveChannels(reader->numChannels);
+      data->Clear();
+      SetData(data, false);
 
-      mNumSamples = (int)mReader->lengthInSamples;
       mOffset = mNumSamples;
-      mOriginalSampleRate = mReader->sampleRate;
+      mOriginalSampleRate = convert ? gSampleRate : (int)reader->sampleRate;
       mSampleRateRatio = float(mOriginalSampleRate) / gSampleRate;
 
-      mReadBuffer = std::make_unique<juce::AudioSampleBuffer>();
-      mReadBuffer->setSize(mReader->numChannels, mNumSamples);
+      bool parallel = reader->getFormatName() == "WAV file" || reader->getFormatName() == "AIFF file"; //cheap to seek around in
+      if (convert)
+         mDecodeTask = SampleDecoder::DecodeAndConvert(file, parallel, fileLength, (int)reader->sampleRate, data, gSampleRate, mPoolKey, cacheFile);
+      else
+         mDecodeTask = SampleDecoder::Decode(file, parallel, data, mOriginalSampleRate, mPoolKey);
 
       if (readType == ReadType::Sync)
-      {
-         mReader->read(mReadBuffer.get(), 0, mNumSamples, 0, true, true);
          FinishRead();
-      }
-      else if (readType == ReadType::Async)
-      {
-         mSamplesLeftToRead = mNumSamples;
-         startTimer(100);
-      }
 
       return true;
    }
@@ -90,57 +117,76 @@ bool Sample::Read(const char* path, bool mono, ReadType readType)
    return false;
 }
 
+//waits for the decode to finish, if there is one
 void Sample::FinishRead()
 {
-   if (mData.NumActiveChannels() == 1 && mReadBuffer->getNumChannels() > 1)
-   {
-      BufferCopy(mData.GetChannel(0), mReadBuffer->getReadPointer(0), mReadBuffer->getNumSamples()); //put first channel in
-      for (int ch = 1; ch < mReadBuffer->getNumChannels(); ++ch)
-         Add(mData.GetChannel(0), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples()); //add the other channels
-      Mult(mData.GetChannel(0), 1.0f / mReadBuffer->getNumChannels(), mReadBuffer->getNumSamples()); //normalize volume
-   }
-   else
-   {
-      for (int ch = 0; ch < mReadBuffer->getNumChannels(); ++ch)
-         BufferCopy(mData.GetChannel(ch), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples());
-   }
+   if (mDecodeTask == nullptr)
+      return;
+
+   mDecodeTask->Wait();
+   if (mDecodeTask->IsPooled())
+      mDataShared = true;
+   mDecodeTask = nullptr;
 }
 
-//juce::Timer
-void Sample::timerCallback()
+void Sample::CancelRead()
 {
-   int samplesToRead = 44100 * 10;
-   if (samplesToRead > mSamplesLeftToRead)
-      samplesToRead = mSamplesLeftToRead;
-   int startSample = mNumSamples - mSamplesLeftToRead;
-   mReader->read(mReadBuffer.get(), startSample, samplesToRead, startSample, true, true);
-   mSamplesLeftToRead -= samplesToRead;
-
-   if (mSamplesLeftToRead <= 0)
-   {
-      FinishRead();
-      stopTimer();
-   }
+   if (mDecodeTask == nullptr)
+      return;
+
+   mDecodeTask->Cancel(); //the workers hold on to the data until they notice, so no need to wait for them
+   mDecodeTask = nullptr;
 }
 
 void Sample::Create(int length)
 {
-   mData.Resize(length);
-   mData.SetNumActiveChannels(1);
+   CancelRead();
+   auto newData = std::make_shared<ChannelBuffer>(length);
+   newData->SetNumActiveChannels(1);
+   SetData(newData, false);
    Setup(length);
 }
 
 void Sample::Create(ChannelBuffer* data)
 {
+   CancelRead();
    int channels = data->NumActiveChannels();
    int length = data->BufferSize();
-   mData.Resize(length);
-   mData.SetNumActiveChannels(channels);
+   auto newData = std::make_shared<ChannelBuffer>(length);
+   newData->SetNumActiveChannels(channels);
    for (int ch = 0; ch < channels; ++ch)
-      BufferCopy(mData.GetChannel(ch), data->GetChannel(ch), length);
+      BufferCopy(newData->GetChannel(ch), data->GetChannel(ch), length);
+   SetData(newData, false);
    Setup(length);
 }
 
+void Sample::SetData(std::shared_ptr<ChannelBuffer> data, bool shared)
+{
+   LockDataMutex(true);
+   std::shared_ptr<ChannelBuffer> oldData = mData; //keep it alive until nothing is reading it
+   mData = data;
+   mDataShared = shared;
+   mNumSamples = data->BufferSize();
+   mPlaybackData = data.get();
+   while (mPlaybackReaders > 0) //an audio thread could still be reading the old data
+      std::this_thread::yield();
+   LockDataMutex(false);
+}
+
+ChannelBuffer* Sample::EditData()
+{
+   FinishRead();
+   if (mDataShared)
+   {
+      auto data = std::make_shared<ChannelBuffer>(mData->BufferSize());
+      data->CopyFrom(mData.get());
+      int numSamples = mNumSamples;
+      SetData(data, false);
+      mNumSamples = numSamples;
+   }
+   return mData.get();
+}
+
 void Sample::Setup(int length)
 {
    mNumSamples = length;
@@ -155,8 +201,9 @@ void Sample::Setup(int length)
 
 bool Sample::Write(const char* path /*=nullptr*/)
 {
+   FinishRead();
    const std::string writeTo = path ? path : mReadPath;
-   WriteDataToFile(writeTo, &mData, mNumSamples);
+   WriteDataToFile(writeTo, mData.get(), mNumSamples);
    return true;
 }
 
@@ -190,129 +237,151 @@ bool Sample::WriteDataToFile(const std::string& path, ChannelBuffer* data, int n
 
 void Sample::Play(double startTime, float rate /*=1*/, int offset /*=0*/, int stopPoint /*=-1*/)
 {
-   mPlayMutex.lock();
-   mStartTime = startTime;
-   mOffset = offset;
-   mRate = rate;
-   if (stopPoint != -1)
-      SetStopPoint(stopPoint);
-   else
-      ClearStopPoint();
-   mPlayMutex.unlock();
+   if (IsAudioThread())
+   {
+      ApplyPendingPlay(); //so that an older request doesn't override this one later
+      mStartTime = startTime;
+      mOffset = offset;
+      mRate = rate;
+      mStopPoint = stopPoint;
+      return;
+   }
+
+   int state = mPendingPlayState.load();
+   while (state == kPlayRequest_Writing || !mPendingPlayState.compare_exchange_weak(state, kPlayRequest_Writing))
+   {
+      std::this_thread::yield();
+      state = mPendingPlayState.load();
+   }
+   mPendingPlay.mStartTime = startTime;
+   mPendingPlay.mOffset = offset;
+   mPendingPlay.mRate = rate;
+   mPendingPlay.mStopPoint = stopPoint;
+   mPendingPlayState = kPlayRequest_Ready;
+}
+
+void Sample::ApplyPendingPlay()
+{
+   int state = kPlayRequest_Ready;
+   if (!mPendingPlayState.compare_exchange_strong(state, kPlayRequest_Writing))
+      return; //nothing waiting, or it's still being written and we'll get it next time
+
+   mStartTime = mPendingPlay.mStartTime;
+   mOffset = mPendingPlay.mOffset;
+   mRate = mPendingPlay.mRate;
+   mStopPoint = mPendingPlay.mStopPoint;
+   mPendingPlayState = kPlayRequest_None;
+}
+
+void Sample::Reset()
+{
+   int state = kPlayRequest_Ready;
+   mPendingPlayState.compare_exchange_strong(state, kPlayRequest_None); //a Play() that hasn't started yet shouldn't start after this
+   mOffset = mNumSamples;
 }
 
 bool Sample::ConsumeData(double time, ChannelBuffer* out, int size, bool replace)
 {
    assert(size <= out->BufferSize());
 
-   mPlayMutex.lock();
-   float end = mNumSamples;
+   ApplyPendingPlay();
+
+   ++mPlaybackReaders;
+   ChannelBuffer* data = mPlaybackData;
+   int numSamples = MIN(mNumSamples, data->BufferSize());
+
+   double end = numSamples;
    if (mStopPoint != -1)
       end = mStopPoint;
 
    if (mLooping && mOffset < 0)
-      mOffset += mNumSamples;
-   if (mLooping && mOffset >= mNumSamples)
-      mOffset -= mNumSamples;
+      mOffset += numSamples;
+   if (mLooping && mOffset >= numSamples)
+      mOffset -= numSamples;
 
    if (mOffset < 0 || mOffset >= end || std::isnan(mOffset))
    {
-      mPlayMutex.unlock();
+      --mPlaybackReaders;
       return false;
    }
 
-   LockDataMutex(true);
-   for (int i = 0; i < size; ++i)
-   {
-      if (time < mStartTime)
-      {
-         if (replace)
-         {
-            for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
-               out->GetChannel(ch)[i] = 0;
-         }
-      }
-      else
-      {
-         for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
-         {
-            int dataChannel = MIN(ch, mData.NumActiveChannels() - 1);
-
-            float sample = 0;
-            if (mOffset < end || mLooping)
-               sample = GetInterpolatedSample(mOffset, mData.GetChannel(dataChannel), mNumSamples) * mVolume;
+   //split the buffer into before mStartTime, playing, and after we've hit the end
+   int preStart = 0;
+   while (preStart < size && time + preStart * gInvSampleRateMs < mStartTime)
+      ++preStart;
 
-            if (replace)
-               out->GetChannel(ch)[i] = sample;
-            else
-               out->GetChannel(ch)[i] += sample;
-         }
+   double increment = mRate * mSampleRateRatio;
+   int playing = size - preStart;
+   if (!mLooping && increment > 0)
+      playing = MIN(playing, (int)ceil((end - mOffset) / increment));
+   int postEnd = size - preStart - playing;
 
-         mOffset += mRate * mSampleRateRatio;
-      }
-      time += gInvSampleRateMs;
+   for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
+   {
+      int dataChannel = MIN(ch, data->NumActiveChannels() - 1);
+      float* dest = out->GetChannel(ch);
+      if (replace)
+         ::Clear(dest, preStart);
+      Interpolation::ReadBlock(mOffset, increment, data->GetChannel(dataChannel), numSamples, dest + preStart, playing, mInterpolationQuality, mVolume, !replace);
+      if (replace)
+         ::Clear(dest + preStart + playing, postEnd);
    }
-   LockDataMutex(false);
-   mPlayMutex.unlock();
+
+   mOffset += increment * (size - preStart);
+   --mPlaybackReaders;
 
    return true;
 }
 
+//the edits below always build new data rather than changing it in place, since it could be shared
+
 void Sample::PadBack(int amount)
 {
-   //TODO(Ryan)
-   /*int newSamples = mNumSamples + amount;
-   float* newData = new float[newSamples];
-   BufferCopy(newData, mData, mNumSamples);
-   Clear(newData+mNumSamples, amount);
-   LockDataMutex(true);
-   delete mData;
-   mData = newData;
-   LockDataMutex(false);
-   mNumSamples = newSamples;*/
+   FinishRead();
+   auto data = std::make_shared<ChannelBuffer>(mNumSamples + amount);
+   data->CopyFrom(mData.get(), mNumSamples); //the padding starts out silent
+   SetData(data, false);
 }
 
 void Sample::ClipTo(int start, int end)
 {
-   //TODO(Ryan)
-   /*assert(start < end);
+   FinishRead();
+   assert(start < end);
    assert(end <= mNumSamples);
-   int newSamples = end-start;
-   float* newData = new float[newSamples];
-   BufferCopy(newData, mData+start, newSamples);
-   LockDataMutex(true);
-   delete mData;
-   mData = newData;
-   LockDataMutex(false);
-   mNumSamples = newSamples;*/
+   auto data = std::make_shared<ChannelBuffer>(end - start);
+   data->CopyFrom(mData.get(), end - start, start);
+   SetData(data, false);
 }
 
 void Sample::ShiftWrap(int numSamplesToShift)
 {
-   //TODO(Ryan)
-   /*assert(numSamplesToShift <= mNumSamples);
-   float* newData = new float[mNumSamples];
+   FinishRead();
+   assert(numSamplesToShift <= mNumSamples);
+   auto data = std::make_shared<ChannelBuffer>(mNumSamples);
+   data->SetNumActiveChannels(mData->NumActiveChannels());
    int chunk = mNumSamples - numSamplesToShift;
-   BufferCopy(newData, mData+numSamplesToShift, chunk);
-   BufferCopy(newData+chunk, mData, numSamplesToShift);
-   LockDataMutex(true);
-   delete mData;
-   mData = newData;
-   LockDataMutex(false);*/
+   for (int ch = 0; ch < mData->NumActiveChannels(); ++ch)
+   {
+      BufferCopy(data->GetChannel(ch), mData->GetChannel(ch) + numSamplesToShift, chunk);
+      BufferCopy(data->GetChannel(ch) + chunk, mData->GetChannel(ch), numSamplesToShift);
+   }
+   SetData(data, false);
 }
 
 void Sample::CopyFrom(Sample* sample)
 {
+   CancelRead();
+   sample->FinishRead();
+   SetData(sample->mData, true); //share it, whichever one edits it first will make its own copy
+   sample->mDataShared = true;
    mNumSamples = sample->mNumSamples;
-   if (mData.BufferSize() != sample->mData.BufferSize())
-      mData.Resize(sample->mNumSamples);
-   mData.CopyFrom(&sample->mData);
    mNumBars = sample->mNumBars;
    mLooping = sample->mLooping;
    mRate = sample->mRate;
    mOriginalSampleRate = sample->mOriginalSampleRate;
    mSampleRateRatio = sample->mSampleRateRatio;
    mStopPoint = sample->mStopPoint;
+   mInterpolationQuality = sample->mInterpolationQuality;
    mName = sample->mName;
    mReadPath = sample->mReadPath;
 }
@@ -324,11 +393,13 @@ namespace
 
 void Sample::SaveState(FileStreamOut& out)
 {
+   FinishRead();
+
    out << kSaveStateRev;
 
    out << mNumSamples;
    if (mNumSamples > 0)
-      mData.Save(out, mNumSamples);
+      mData->Save(out, mNumSamples);
    out << mNumBars;
    out << mLooping;
    out << mRate;
@@ -343,11 +414,17 @@ void Sample::LoadState(FileStreamIn& in)
    int rev;
    in >> rev;
 
+   CancelRead();
+
    in >> mNumSamples;
    if (mNumSamples > 0)
    {
       int readLength;
-      mData.Load(in, readLength, ChannelBuffer::LoadMode::kSetBufferSize);
+      int numSamples = mNumSamples;
+      auto data = std::make_shared<ChannelBuffer>(numSamples);
+      data->Load(in, readLength, ChannelBuffer::LoadMode::kSetBufferSize);
+      SetData(data, false);
+      mNumSamples = numSamples;
       assert(readLength == mNumSamples);
       /*for (int ch=0; ch<mData.NumActiveChannels(); ++ch)
       {
@@ -27,22 +27,19 @@
 
 #include "OpenFrameworksPort.h"
 #include "ChannelBuffer.h"
+#include "Interpolation.h"
+#include "SampleDecoder.h"
+#include "SamplePool.h"
+#include <atomic>
 #include <limits>
+#include <memory>
 
 #include "juce_events/juce_events.h"
 
 class FileStreamOut;
 class FileStreamIn;
 
-namespace juce
-{
-   class AudioFormatReader;
-   template <typename T>
-   class AudioBuffer;
-   using AudioSampleBuffer = AudioBuffer<float>;
-}
-
-class Sample : public juce::Timer
+class Sample
 {
 public:
    enum class ReadType
@@ -61,13 +58,14 @@ public:
    std::string Name() const { return mName; }
    void SetName(std::string name) { mName = name; }
    int LengthInSamples() const { return mNumSamples; }
-   int NumChannels() const { return mData.NumActiveChannels(); }
-   ChannelBuffer* Data() { return &mData; }
+   int NumChannels() const { return mData->NumActiveChannels(); }
+   ChannelBuffer* Data() { return mData.get(); } //can be shared with other samples (see SamplePool), so only read from it
+   ChannelBuffer* EditData(); //for writing, gets us our own copy first if the data is shared
    double GetPlayPosition() const { return mOffset; }
    void SetPlayPosition(double sample) { mOffset = sample; }
    float GetSampleRateRatio() const { return mSampleRateRatio; }
    float GetOriginalSampleRate() const { return mOriginalSampleRate; }
-   void Reset() { mOffset = mNumSamples; }
+   void Reset();
    void SetStopPoint(int stopPoint) { mStopPoint = stopPoint; }
    void ClearStopPoint() { mStopPoint = -1; }
    void PadBack(int amount);
@@ -76,7 +74,7 @@ public:
    std::string GetReadPath() const { return mReadPath; }
    static bool WriteDataToFile(const std::string& path, float** data, int numSamples, int channels = 1);
    static bool WriteDataToFile(const std::string& path, ChannelBuffer* data, int numSamples);
-   bool IsPlaying() const { return mOffset < mNumSamples; }
+   bool IsPlaying() const { return mPendingPlayState == kPlayRequest_Ready || mOffset < mNumSamples; } //including a Play() that ConsumeData() hasn't picked up yet
    void LockDataMutex(bool lock) { lock ? mDataMutex.lock() : mDataMutex.unlock(); }
    void Create(int length);
    void Create(ChannelBuffer* data);
@@ -84,20 +82,29 @@ public:
    void SetNumBars(int numBars) { mNumBars = numBars; }
    int GetNumBars() const { return mNumBars; }
    void SetVolume(float vol) { mVolume = vol; }
+   void SetInterpolationQuality(InterpolationQuality quality) { mInterpolationQuality = quality; }
+   InterpolationQuality GetInterpolationQuality() const { return mInterpolationQuality; }
    void CopyFrom(Sample* sample);
-   bool IsSampleLoading() { return mSamplesLeftToRead > 0; }
-   float GetSampleLoadProgress() { return (mNumSamples > 0) ? (1 - (float(mSamplesLeftToRead) / mNumSamples)) : 1; }
+   bool IsSampleLoading() { return mDecodeTask != nullptr && !mDecodeTask->IsDone(); }
+   float GetSampleLoadProgress() { return mDecodeTask != nullptr ? mDecodeTask->GetProgress() : 1; }
 
    void SaveState(FileStreamOut& out);
    void LoadState(FileStreamIn& in);
 
 private:
    void Setup(int length);
+   void SetData(std::shared_ptr<ChannelBuffer> data, bool shared);
+   void ApplyPendingPlay();
    void FinishRead();
-   //juce::Timer
-   void timerCallback();
+   void CancelRead();
 
-   ChannelBuffer mData{ 0 };
+   std::shared_ptr<ChannelBuffer> mData{ std::make_shared<ChannelBuffer>(0) };
+   //what ConsumeData() reads from, without locking. SetData() swaps it and then waits for any ConsumeData() in progress to finish before
+   //letting go of the old data.
+   std::atomic<ChannelBuffer*> mPlaybackData{ mData.get() };
+   std::atomic<int> mPlaybackReaders{ 0 };
+   bool mDataShared{ false }; //in the pool or used by another sample, so never write to it in place
+   SamplePool::Key mPoolKey;
    int mNumSamples{ 0 };
    double mStartTime{ 0 };
    double mOffset{ std::numeric_limits<double>::max() };
@@ -108,12 +115,27 @@ private:
    std::string mName{ "" };
    std::string mReadPath{ "" };
    ofMutex mDataMutex;
-   ofMutex mPlayMutex;
    bool mLooping{ false };
    int mNumBars{ -1 };
    float mVolume{ 1 };
+   InterpolationQuality mInterpolationQuality{ InterpolationQuality::Linear };
 
-   juce::AudioFormatReader* mReader{};
-   std::unique_ptr<juce::AudioSampleBuffer> mReadBuffer;
-   int mSamplesLeftToRead{ 0 };
+   std::shared_ptr<SampleDecoder::Task> mDecodeTask;
+
+   //Play() from off the audio thread gets handed over here, and applied at the start of the next ConsumeData()
+   struct PlayRequest
+   {
+      double mStartTime{ 0 };
+      double mOffset{ 0 };
+      float mRate{ 1 };
+      int mStopPoint{ -1 };
+   };
+   enum PlayRequestState
+   {
+      kPlayRequest_None,
+      kPlayRequest_Writing,
+      kPlayRequest_Ready
+   };
+   PlayRequest mPendingPlay;
+   std::atomic<int> mPendingPlayState{ kPlayRequest_None };
 };
@@ -0,0 +1,325 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleAnalysis.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+
+#include "SampleAnalysis.h"
+#include "Sample.h"
+#include "FFT.h"
+#include "FileStream.h"
+#include "PitchDetector.h"
+#include "SynthGlobals.h"
+
+#include <algorithm>
+
+#include "juce_cryptography/juce_cryptography.h"
+
+namespace
+{
+   const int kFFTSize = 1024;
+   const int kCacheFileVersion = 1;
+   const size_t kMaxCachedResults = 64;
+   const float kVoicedConfidence = .7f; //PitchDetector's own threshold
+   const double kMinOnsetSpacingSeconds = .05;
+   const int kOnsetThresholdFrames = 8; //either side, for the moving average that a peak has to stand out from
+   const float kMinTempo = 60;
+   const float kMaxTempo = 180;
+
+   juce::ThreadPool& GetThreadPool()
+   {
+      static juce::ThreadPool sThreadPool(juce::jlimit(1, 2, juce::SystemStats::getNumCpus() - 1));
+      return sThreadPool;
+   }
+}
+
+std::mutex SampleAnalysis::sMutex;
+std::map<std::string, std::shared_ptr<const SampleAnalysis::Result>> SampleAnalysis::sResults;
+
+void SampleAnalysis::Task::Wait()
+{
+   std::unique_lock<std::mutex> lock(mDoneMutex);
+   mDoneCondition.wait(lock, [this]
+                       { return mDone.load(); });
+}
+
+//static
+std::shared_ptr<SampleAnalysis::Task> SampleAnalysis::Analyze(Sample* sample)
+{
+   auto task = std::make_shared<Task>();
+   task->mSampleRate = (int)sample->GetOriginalSampleRate();
+   sample->LockDataMutex(true);
+   int length = std::min(sample->LengthInSamples(), sample->Data()->BufferSize());
+   if (length > 0)
+      task->mInput.assign(sample->Data()->GetChannel(0), sample->Data()->GetChannel(0) + length);
+   sample->LockDataMutex(false);
+
+   GetThreadPool().addJob([task]
+                          { Run(task); });
+   return task;
+}
+
+//static
+void SampleAnalysis::Run(std::shared_ptr<Task> task)
+{
+   juce::String hash = juce::MD5(task->mInput.data(), task->mInput.size() * sizeof(float)).toHexString() + "_" + juce::String(task->mSampleRate);
+   std::string key = hash.toStdString();
+
+   std::shared_ptr<const Result> result;
+   {
+      std::lock_guard<std::mutex> lock(sMutex);
+      auto iter = sResults.find(key);
+      if (iter != sResults.end())
+         result = iter->second;
+   }
+
+   if (result == nullptr)
+   {
+      result = ReadCacheFile(key);
+      if (result == nullptr)
+      {
+         auto computed = Compute(task->mInput, task->mSampleRate);
+         WriteCacheFile(key, *computed);
+         result = computed;
+      }
+
+      std::lock_guard<std::mutex> lock(sMutex);
+      if (sResults.size() >= kMaxCachedResults)
+         sResults.clear();
+      sResults[key] = result;
+   }
+
+   task->mInput.clear();
+   task->mInput.shrink_to_fit();
+
+   std::lock_guard<std::mutex> lock(task->mDoneMutex);
+   task->mResult = result;
+   task->mDone = true;
+   task->mDoneCondition.notify_all();
+}
+
+//static
+std::shared_ptr<SampleAnalysis::Result> SampleAnalysis::Compute(std::vector<float>& input, int sampleRate)
+{
+   auto result = std::make_shared<Result>();
+   result->mSampleRate = sampleRate;
+
+   const int length = (int)input.size();
+   const int numFrames = (length + kHopSize - 1) / kHopSize;
+   const int numBins = kFFTSize / 2 + 1;
+
+   //spectral flux (of log magnitudes) and centroid, from frames centered on each hop
+   ::FFT fft(kFFTSize);
+   std::vector<float> window(kFFTSize);
+   for (int i = 0; i < kFFTSize; ++i)
+      window[i] = .5f - .5f * cos(FTWO_PI * i / kFFTSize);
+   std::vector<float> frame(kFFTSize);
+   std::vector<float> real(numBins);
+   std::vector<float> imag(numBins);
+   std::vector<float> logMagnitude(numBins);
+   std::vector<float> lastLogMagnitude(numBins, 0);
+   std::vector<float> flux(numFrames);
+   result->mCentroid.resize(numFrames);
+   for (int f = 0; f < numFrames; ++f)
+   {
+      int start = f * kHopSize - kFFTSize / 2;
+      for (int i = 0; i < kFFTSize; ++i)
+      {
+         int pos = start + i;
+         frame[i] = (pos >= 0 && pos < length) ? input[pos] * window[i] : 0;
+      }
+      fft.Forward(frame.data(), real.data(), imag.data());
+
+      float weighted = 0;
+      float total = 0;
+      float frameFlux = 0;
+      for (int bin = 0; bin < numBins; ++bin)
+      {
+         float magnitude = sqrtf(real[bin] * real[bin] + imag[bin] * imag[bin]);
+         weighted += bin * magnitude;
+         total += magnitude;
+         logMagnitude[bin] = log1pf(100 * magnitude);
+         frameFlux += std::max(logMagnitude[bin] - lastLogMagnitude[bin], 0.0f);
+      }
+      flux[f] = frameFlux;
+      result->mCentroid[f] = total > 0 ? weighted / total * sampleRate / kFFTSize : 0;
+      lastLogMagnitude.swap(logMagnitude);
+   }
+
+   //onsets are peaks in the flux that stand out from the flux around them
+   float maxFlux = numFrames > 0 ? *std::max_element(flux.begin(), flux.end()) : 0;
+   int minSpacing = (int)ceil(kMinOnsetSpacingSeconds * sampleRate / kHopSize);
+   int lastOnsetFrame = -minSpacing;
+   for (int f = 1; f < numFrames - 1; ++f)
+   {
+      float sum = 0;
+      int count = 0;
+      for (int i = std::max(f - kOnsetThresholdFrames, 0); i <= std::min(f + kOnsetThresholdFrames, numFrames - 1); ++i)
+      {
+         sum += flux[i];
+         ++count;
+      }
+      float threshold = sum / count * 1.5f + maxFlux * .05f;
+      if (flux[f] > threshold && flux[f] >= flux[f - 1] && flux[f] > flux[f + 1] && f - lastOnsetFrame >= minSpacing)
+      {
+         result->mOnsets.push_back(f * kHopSize);
+         lastOnsetFrame = f;
+      }
+   }
+
+   //tempo is the strongest periodicity of the flux, leaning towards 120bpm to keep it from picking double or half time
+   if (result->mOnsets.size() >= 4)
+   {
+      float mean = 0;
+      for (float value : flux)
+         mean += value;
+      mean /= numFrames;
+      int minLag = std::max((int)(60.0f * sampleRate / (kMaxTempo * kHopSize)), 1);
+      int maxLag = std::min((int)(60.0f * sampleRate / (kMinTempo * kHopSize)) + 1, numFrames - 1);
+      std::vector<float> strength(maxLag + 2, 0);
+      int bestLag = -1;
+      for (int lag = minLag; lag <= maxLag; ++lag)
+      {
+         float sum = 0;
+         for (int i = 0; i + lag < numFrames; ++i)
+            sum += (flux[i] - mean) * (flux[i + lag] - mean);
+         float bpm = 60.0f * sampleRate / (lag * kHopSize);
+         float octavesFrom120 = log2f(bpm / 120);
+         strength[lag] = sum / (numFrames - lag) * expf(-.5f * octavesFrom120 * octavesFrom120);
+         if (bestLag == -1 || strength[lag] > strength[bestLag])
+            bestLag = lag;
+      }
+      if (bestLag > 0 && strength[bestLag] > 0)
+      {
+         float lag = bestLag;
+         if (bestLag > minLag && bestLag < maxLag) //parabolic interpolation between lags
+         {
+            float a = strength[bestLag - 1];
+            float b = strength[bestLag];
+            float c = strength[bestLag + 1];
+            float denominator = a - 2 * b + c;
+            if (denominator != 0)
+               lag += .5f * (a - c) / denominator;
+         }
+         result->mTempo = 60.0f * sampleRate / (lag * kHopSize);
+      }
+   }
+
+   //pitch, a frame at a time. PitchDetector also steps every kHopSize samples, and assumes gSampleRate, so correct for that.
+   PitchDetector pitchDetector;
+   float rateCorrection = 12 * log2f(float(sampleRate) / gSampleRate);
+   std::vector<float> voiced;
+   result->mPitchTrack.resize(numFrames);
+   for (int f = 0; f < numFrames; ++f)
+   {
+      int start = f * kHopSize;
+      float pitch = pitchDetector.DetectPitch(input.data() + start, std::min(kHopSize, length - start));
+      if (pitchDetector.GetConfidence() >= kVoicedConfidence)
+      {
+         result->mPitchTrack[f] = pitch + rateCorrection;
+         voiced.push_back(result->mPitchTrack[f]);
+      }
+   }
+   if (!voiced.empty())
+   {
+      std::nth_element(voiced.begin(), voiced.begin() + voiced.size() / 2, voiced.end());
+      result->mPitch = voiced[voiced.size() / 2];
+   }
+
+   return result;
+}
+
+//static
+juce::File SampleAnalysis::GetCacheFile(const std::string& hash)
+{
+   return juce::File(ofToDataPath("cache/analysis/" + hash + ".bin"));
+}
+
+//static
+std::shared_ptr<const SampleAnalysis::Result> SampleAnalysis::ReadCacheFile(const std::string& hash)
+{
+   juce::File file = GetCacheFile(hash);
+   if (!file.existsAsFile())
+      return nullptr;
+
+   FileStreamIn in(file.getFullPathName().toStdString());
+   if (!in.OpenedOk())
+      return nullptr;
+   int version = -1;
+   in >> version;
+   if (version != kCacheFileVersion)
+      return nullptr;
+
+   //a truncated or corrupt file shouldn't make us allocate (or read) more than it could possibly hold, so check each count against
+   //what's left of the file, and return nullptr to recompute it instead
+   const juce::int64 fileSize = file.getSize();
+   auto fits = [&in, fileSize](int count, size_t bytesEach)
+   {
+      return count >= 0 && (juce::int64)count * (juce::int64)bytesEach <= fileSize - in.GetFilePosition();
+   };
+
+   auto result = std::make_shared<Result>();
+   int numOnsets = -1;
+   int numFrames = -1;
+   in >> result->mSampleRate;
+   in >> result->mTempo;
+   in >> result->mPitch;
+   in >> numOnsets;
+   if (!fits(numOnsets, sizeof(int)))
+      return nullptr;
+   result->mOnsets.resize(numOnsets);
+   for (auto& onset : result->mOnsets)
+      in >> onset;
+   in >> numFrames;
+   if (!fits(numFrames, sizeof(float) * 2))
+      return nullptr;
+   result->mPitchTrack.resize(numFrames);
+   result->mCentroid.resize(numFrames);
+   in.Read(result->mPitchTrack.data(), numFrames);
+   in.Read(result->mCentroid.data(), numFrames);
+   return result;
+}
+
+//static
+void SampleAnalysis::WriteCacheFile(const std::string& hash, const Result& result)
+{
+   juce::File file = GetCacheFile(hash);
+   file.getParentDirectory().createDirectory();
+   juce::TemporaryFile tempFile(file);
+   {
+      FileStreamOut out(tempFile.getFile().getFullPathName().toStdString());
+      out << kCacheFileVersion;
+      out << result.mSampleRate;
+      out << result.mTempo;
+      out << result.mPitch;
+      out << (int)result.mOnsets.size();
+      for (int onset : result.mOnsets)
+         out << onset;
+      out << (int)result.mPitchTrack.size();
+      out.Write(result.mPitchTrack.data(), (int)result.mPitchTrack.size());
+      out.Write(result.mCentroid.data(), (int)result.mCentroid.size());
+   }
+   tempFile.overwriteTargetFileWithTemporary();
+}
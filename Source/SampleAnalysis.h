@@ -0,0 +1,94 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleAnalysis.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Sample;
+
+namespace juce
+{
+   class File;
+}
+
+//onsets, tempo, pitch and spectral centroid for a sample, worked out on a pool of worker threads.
+//results are keyed on a hash of the audio itself, kept in memory and in a small binary file per sample in userdata/cache/analysis, so the
+//same audio (reloaded, in another module, or in the next session) never gets analysed twice.
+class SampleAnalysis
+{
+public:
+   static constexpr int kHopSize = 512; //samples per frame of the per-frame tracks
+
+   struct Result
+   {
+      int mSampleRate{ 0 };
+      std::vector<int> mOnsets; //sample positions
+      float mTempo{ 0 }; //bpm, 0 if there aren't enough onsets to tell
+      float mPitch{ 69 }; //midi pitch, the median of the voiced frames. 69 if there weren't any, like PitchDetector.
+      std::vector<float> mPitchTrack; //midi pitch per frame, 0 where it's unvoiced
+      std::vector<float> mCentroid; //spectral centroid per frame, in hz
+   };
+
+   class Task
+   {
+   public:
+      bool IsDone() const { return mDone; }
+      void Wait();
+      std::shared_ptr<const Result> GetResult() const { return mDone ? mResult : nullptr; }
+
+   private:
+      friend class SampleAnalysis;
+
+      std::vector<float> mInput;
+      int mSampleRate{ 0 };
+      std::shared_ptr<const Result> mResult;
+      std::atomic<bool> mDone{ false };
+      std::mutex mDoneMutex;
+      std::condition_variable mDoneCondition;
+   };
+
+   //analyses the sample's first channel, so it should be done loading. it's copied first, so the sample is free to change while this runs.
+   static std::shared_ptr<Task> Analyze(Sample* sample);
+
+private:
+   static void Run(std::shared_ptr<Task> task);
+   static std::shared_ptr<Result> Compute(std::vector<float>& input, int sampleRate);
+   static std::shared_ptr<const Result> ReadCacheFile(const std::string& hash);
+   static void WriteCacheFile(const std::string& hash, const Result& result);
+   static juce::File GetCacheFile(const std::string& hash);
+
+   static std::mutex sMutex;
+   static std::map<std::string, std::shared_ptr<const Result>> sResults;
+};
@@ -39,6 +39,8 @@ using namespace juce;
 SampleBrowser::SampleBrowser()
 {
    mCurrentDirectory = ofToSamplePath("");
+   mIndex = SampleIndex::Acquire();
+   mIndex->AddRoot(SampleIndex::GetKey(File(ofToSamplePath(""))));
 }
 
 SampleBrowser::~SampleBrowser()
@@ -49,7 +51,9 @@ void SampleBrowser::CreateUIControls()
 {
    IDrawableModule::CreateUIControls();
 
-   UIBLOCK(3, 20);
+   UIBLOCK(3, 3);
+   TEXTENTRY(mSearchEntry, "search", 15, mSearch);
+   UIBLOCK_SHIFTY(15);
    for (int i = 0; i < (int)mButtons.size(); ++i)
    {
       xOffset += 270;
@@ -69,14 +73,34 @@ void SampleBrowser::CreateUIControls()
    BUTTON(mStopButton, "stop");
    ENDUIBLOCK0();
 
+   mSearchEntry->DrawLabel(true);
+
    SetDirectory(mCurrentDirectory);
 }
 
+void SampleBrowser::Poll()
+{
+   //the listing comes from the index, so keep it up to date as the index scans. not every frame though, while a big library is being
+   //indexed it changes constantly.
+   bool searchChanged = mListingSearch != mSearch;
+   if (searchChanged || (mIndex->GetGeneration() != mListingGeneration && juce::Time::getMillisecondCounter() - mListingTime > 500))
+      UpdateListing(searchChanged);
+}
+
 void SampleBrowser::DrawModule()
 {
    if (Minimized() || IsVisible() == false)
       return;
 
+   mSearchEntry->Draw();
+
+   int pendingDirectories = mIndex->GetNumPendingDirectories();
+   if (pendingDirectories > 0 || !mListingScanned)
+   {
+      ofRectangle searchRect = mSearchEntry->GetRect(K(local));
+      DrawTextNormal("indexing... " + ofToString(pendingDirectories), searchRect.getMaxX() + 5, 14);
+   }
+
    float fontSize = 13;
    float stringWidth = gFont.GetStringWidth(mCurrentDirectory.toStdString(), fontSize);
    float moduleWidth, moduleHeight;
@@ -84,7 +108,7 @@ void SampleBrowser::DrawModule()
    float textX = 3;
    if (stringWidth > moduleWidth)
       textX = moduleWidth - 3 - stringWidth;
-   gFont.DrawString(mCurrentDirectory.toStdString(), fontSize, textX, 15);
+   gFont.DrawString(mCurrentDirectory.toStdString(), fontSize, textX, 33);
 
    assert(mButtons.size() == mPlayButtons.size());
 
@@ -95,6 +119,23 @@ void SampleBrowser::DrawModule()
 
       mButtons[i]->Draw();
 
+      if (mButtons[i]->IsShowing() && entryIndex < (int)mDirectoryListing.size() && mDirectoryListing[entryIndex].mLengthInSamples > 0)
+      {
+         //waveform thumbnail from the index
+         const auto& thumbnail = mDirectoryListing[entryIndex].mThumbnail;
+         ofRectangle rect = mButtons[i]->GetRect(K(local));
+         float centerY = rect.y + rect.height / 2;
+         ofPushStyle();
+         ofSetColor(255, 255, 255, 40);
+         for (int j = 0; j < SampleIndex::kThumbnailSize; ++j)
+         {
+            float x = rect.x + 20 + (rect.width - 20) * (j + .5f) / SampleIndex::kThumbnailSize;
+            float height = thumbnail[j] / 255.0f * (rect.height / 2 - 1);
+            ofLine(x, centerY - height, x, centerY + height);
+         }
+         ofPopStyle();
+      }
+
       mPlayButtons[i]->SetDisplayStyle(IsSamplePlaying(entryIndex) ? ButtonDisplayStyle::kStop : ButtonDisplayStyle::kPlay);
       mPlayButtons[i]->Draw();
 
@@ -119,7 +160,7 @@ void SampleBrowser::DrawModule()
 
 bool SampleBrowser::IsMostRecentlyPlayedSample(int index) const
 {
-   return mDirectoryListing[index] == juce::String(mPlayingSample.GetReadPath());
+   return index < (int)mDirectoryListing.size() && mDirectoryListing[index].mPath == mPlayingSample.GetReadPath();
 }
 
 bool SampleBrowser::IsSamplePlaying(int index) const
@@ -139,14 +180,14 @@ void SampleBrowser::ButtonClicked(ClickButton* button, double time)
       std::vector<int> sampleIndices;
       for (int i = 0; i < (int)mDirectoryListing.size(); ++i)
       {
-         if (!File(mDirectoryListing[i]).isDirectory())
+         if (!mDirectoryListing[i].mIsDirectory)
             sampleIndices.push_back(i);
       }
       if (sampleIndices.size() > 0)
       {
          int index = sampleIndices[rand() % (int)sampleIndices.size()];
          ShowPage(index / (int)mButtons.size());
-         PlaySample(mDirectoryListing[index]);
+         PlaySample(mDirectoryListing[index].mPath);
       }
    }
 
@@ -161,10 +202,10 @@ void SampleBrowser::ButtonClicked(ClickButton* button, double time)
          int entryIndex = offset + i;
          if (entryIndex < (int)mDirectoryListing.size())
          {
-            String clicked = mDirectoryListing[entryIndex];
+            SampleIndex::Entry clicked = mDirectoryListing[entryIndex];
             if (button == mButtons[i])
             {
-               if (clicked == "..")
+               if (clicked.mPath == "..")
                {
                   File dir(mCurrentDirectory);
                   if (dir.getParentDirectory().getFullPathName() != dir.getFullPathName())
@@ -172,13 +213,13 @@ void SampleBrowser::ButtonClicked(ClickButton* button, double time)
                   else
                      SetDirectory("");
                }
-               else if (File(clicked).isDirectory())
+               else if (clicked.mIsDirectory)
                {
-                  SetDirectory(clicked);
+                  SetDirectory(clicked.mPath);
                }
                else
                {
-                  TheSynth->GrabSample(clicked.toStdString());
+                  TheSynth->GrabSample(clicked.mPath);
                }
             }
             if (button == mPlayButtons[i])
@@ -186,7 +227,7 @@ void SampleBrowser::ButtonClicked(ClickButton* button, double time)
                if (IsSamplePlaying(entryIndex))
                   mPlayingSample.Reset();
                else
-                  PlaySample(clicked);
+                  PlaySample(clicked.mPath);
             }
          }
       }
@@ -197,11 +238,10 @@ void SampleBrowser::PlaySample(juce::String file)
 {
    if (File(file).existsAsFile())
    {
-      mSampleMutex.lock();
+      //async, so it starts playing while it decodes. Sample handles being read and played from here while Process() consumes it.
       mPlayingSample.SetName(file.toStdString().c_str());
-      mPlayingSample.Read(file.toStdString().c_str());
+      mPlayingSample.Read(file.toStdString().c_str(), false, Sample::ReadType::Async);
       mPlayingSample.Play(NextBufferTime(false), 1, 0);
-      mSampleMutex.unlock();
    }
 }
 
@@ -218,10 +258,8 @@ void SampleBrowser::Process(double time)
    assert(bufferSize == gBufferSize);
 
    gWorkChannelBuffer.Clear();
-   mSampleMutex.lock();
    if (mPlayingSample.IsPlaying())
       mPlayingSample.ConsumeData(time, &gWorkChannelBuffer, bufferSize, true);
-   mSampleMutex.unlock();
 
    const int kNumChannels = 2;
    if (gWorkChannelBuffer.NumActiveChannels() == 1)
@@ -239,25 +277,17 @@ void SampleBrowser::Process(double time)
 
 namespace
 {
-   int CompareDirectoryListing(const String& text, const String& other)
-   {
-      if (text == other)
-         return 0;
-      bool isDir = text == ".." || File(text).isDirectory();
-      bool isOtherDir = other == ".." || File(other).isDirectory();
-      if (isDir && !isOtherDir)
-         return -1;
-      if (!isDir && isOtherDir)
-         return 1;
-      return text.compareIgnoreCase(other);
-   }
+   const int kMaxSearchResults = 1000;
 
-   void SortDirectoryListing(StringArray& listing)
+   bool CompareDirectoryListing(const SampleIndex::Entry& entry, const SampleIndex::Entry& other)
    {
-      std::sort(listing.begin(), listing.end(), [](const String& a, const String& b)
-                {
-                   return CompareDirectoryListing(a, b) < 0;
-                });
+      if (entry.mPath == "..")
+         return other.mPath != "..";
+      if (other.mPath == "..")
+         return false;
+      if (entry.mIsDirectory != other.mIsDirectory)
+         return entry.mIsDirectory;
+      return juce::String(entry.mPath).compareIgnoreCase(other.mPath) < 0;
    }
 }
 
@@ -265,40 +295,37 @@ void SampleBrowser::SetDirectory(String dirPath)
 {
    mCurrentDirectory = dirPath;
 
-   mDirectoryListing.clear();
-
    if (dirPath != "")
-   {
-      String matcher = TheSynth->GetAudioFormatManager().getWildcardForAllFormats();
+      mIndex->RequestScan(SampleIndex::GetKey(File(ofToSamplePath(dirPath.toStdString()))));
 
-      StringArray wildcards;
-      wildcards.addTokens(matcher, ";,", "\"'");
-      wildcards.trim();
-      wildcards.removeEmptyStrings();
+   UpdateListing(true);
+}
+
+//the listing is whatever the index has for the current directory (or the search), it never touches the disk itself
+void SampleBrowser::UpdateListing(bool resetPage)
+{
+   mListingGeneration = mIndex->GetGeneration();
+   mListingTime = juce::Time::getMillisecondCounter(); //not gTime, which stands still when audio isn't running
+   mListingSearch = mSearch;
+
+   mDirectoryListing.clear();
 
-      mDirectoryListing.add("..");
+   if (mCurrentDirectory != "")
+   {
+      SampleIndex::Entry parent;
+      parent.mPath = "..";
+      parent.mIsDirectory = true;
+      mDirectoryListing.push_back(parent);
 
-      File dir(ofToSamplePath(dirPath.toStdString()));
-      for (auto& file : dir.findChildFiles(File::findFilesAndDirectories | File::ignoreHiddenFiles, false))
+      std::string dir = SampleIndex::GetKey(File(ofToSamplePath(mCurrentDirectory.toStdString())));
+      if (mListingSearch.empty())
       {
-         bool include = false;
-         if (file.isDirectory())
-         {
-            include = true;
-         }
-         else
-         {
-            for (auto& w : wildcards)
-            {
-               if (file.getFileName().matchesWildcard(w, true))
-               {
-                  include = true;
-                  break;
-               }
-            }
-         }
-         if (include)
-            mDirectoryListing.add(file.getFullPathName().replace(GetPathSeparator(), "/"));
+         mListingScanned = mIndex->GetListing(dir, mDirectoryListing);
+      }
+      else
+      {
+         mIndex->Search(dir, mListingSearch, mDirectoryListing, kMaxSearchResults);
+         mListingScanned = true;
       }
    }
    else
@@ -306,11 +333,17 @@ void SampleBrowser::SetDirectory(String dirPath)
       Array<File> roots;
       File::findFileSystemRoots(roots);
       for (auto& root : roots)
-         mDirectoryListing.add(root.getFullPathName());
+      {
+         SampleIndex::Entry entry;
+         entry.mPath = root.getFullPathName().toStdString();
+         entry.mIsDirectory = true;
+         mDirectoryListing.push_back(entry);
+      }
+      mListingScanned = true;
    }
-   SortDirectoryListing(mDirectoryListing);
+   std::sort(mDirectoryListing.begin(), mDirectoryListing.end(), CompareDirectoryListing);
 
-   ShowPage(0);
+   ShowPage(resetPage ? 0 : mCurrentPage);
 }
 
 void SampleBrowser::ShowPage(int page)
@@ -322,8 +355,9 @@ void SampleBrowser::ShowPage(int page)
    {
       if (i + offset < (int)mDirectoryListing.size())
       {
+         const SampleIndex::Entry& entry = mDirectoryListing[i + offset];
          mButtons[i]->SetShowing(true);
-         if (mDirectoryListing[i + offset] == ".." || File(mDirectoryListing[i + offset]).isDirectory())
+         if (entry.mIsDirectory)
          {
             mButtons[i]->SetDisplayStyle(ButtonDisplayStyle::kFolderIcon);
             mPlayButtons[i]->SetShowing(false);
@@ -334,10 +368,10 @@ void SampleBrowser::ShowPage(int page)
             mPlayButtons[i]->SetShowing(true);
          }
 
-         if (mDirectoryListing[i + offset] == "..")
+         if (entry.mPath == "..")
             mButtons[i]->SetLabel("..");
          else
-            mButtons[i]->SetLabel(File(mDirectoryListing[i + offset]).getFileName().toStdString().c_str());
+            mButtons[i]->SetLabel(File(entry.mPath).getFileName().toStdString().c_str());
       }
       else
       {
@@ -31,8 +31,10 @@
 #include "Sample.h"
 #include "ClickButton.h"
 #include "IAudioSource.h"
+#include "SampleIndex.h"
+#include "TextEntry.h"
 
-class SampleBrowser : public IDrawableModule, public IButtonListener, public IAudioSource
+class SampleBrowser : public IDrawableModule, public IButtonListener, public IAudioSource, public ITextEntryListener
 {
 public:
    SampleBrowser();
@@ -43,11 +45,13 @@ public:
    static bool AcceptsPulses() { return false; }
 
    void CreateUIControls() override;
+   void Poll() override;
 
    //IAudioSource
    void Process(double time) override;
 
    void ButtonClicked(ClickButton* button, double time) override;
+   void TextEntryComplete(TextEntry* entry) override {}
 
    virtual void LoadLayout(const ofxJSONElement& moduleInfo) override;
    virtual void SetUpFromSaveData() override;
@@ -63,10 +67,11 @@ private:
    void GetModuleDimensions(float& width, float& height) override
    {
       width = 300;
-      height = 38 + (int)mButtons.size() * 17;
+      height = 56 + (int)mButtons.size() * 17;
    }
 
    void SetDirectory(juce::String dirPath);
+   void UpdateListing(bool resetPage);
    int GetNumPages() const;
    void ShowPage(int page);
    void PlaySample(juce::String file);
@@ -74,7 +79,14 @@ private:
    bool IsSamplePlaying(int index) const;
 
    juce::String mCurrentDirectory;
-   juce::StringArray mDirectoryListing;
+   std::vector<SampleIndex::Entry> mDirectoryListing;
+   std::shared_ptr<SampleIndex> mIndex;
+   int mListingGeneration{ -1 };
+   juce::uint32 mListingTime{ 0 };
+   bool mListingScanned{ false };
+   TextEntry* mSearchEntry{ nullptr };
+   char mSearch[MAX_TEXTENTRY_LENGTH]{};
+   std::string mListingSearch;
    std::array<ClickButton*, 30> mButtons{ nullptr };
    std::array<ClickButton*, 30> mPlayButtons{ nullptr };
    ClickButton* mBackButton{ nullptr };
@@ -83,5 +95,4 @@ private:
    ClickButton* mStopButton{ nullptr };
    int mCurrentPage{ 0 };
    Sample mPlayingSample;
-   ofMutex mSampleMutex;
 };
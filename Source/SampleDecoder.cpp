@@ -0,0 +1,206 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleDecoder.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "SampleDecoder.h"
+#include "ChannelBuffer.h"
+#include "ModularSynth.h"
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+namespace
+{
+   const int kChunkSize = 1 << 20; //samples per parallel chunk
+   const int kReadBlockSize = 1 << 16; //samples per read within a chunk, how often we update progress and check for cancellation
+
+   juce::ThreadPool& GetThreadPool()
+   {
+      static juce::ThreadPool sThreadPool(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() - 1));
+      return sThreadPool;
+   }
+}
+
+void SampleDecoder::Task::Wait()
+{
+   std::unique_lock<std::mutex> lock(mDoneMutex);
+   mDoneCondition.wait(lock, [this]
+                       { return mChunksLeft == 0; });
+}
+
+void SampleDecoder::Task::ChunkFinished()
+{
+   std::lock_guard<std::mutex> lock(mDoneMutex);
+   if (--mChunksLeft == 0)
+   {
+      if (!mCancelled && !mFailed)
+      {
+         SamplePool::Add(mPoolKey, mData, mSampleRate);
+         mPooled = true;
+      }
+      mDoneCondition.notify_all();
+   }
+}
+
+//static
+std::shared_ptr<SampleDecoder::Task> SampleDecoder::MakeTask(const juce::File& file, std::shared_ptr<ChannelBuffer> data, int sampleRate, const SamplePool::Key& poolKey)
+{
+   auto task = std::make_shared<Task>();
+   task->mFile = file;
+   task->mData = data;
+   task->mNumSamples = data->BufferSize();
+   task->mSampleRate = sampleRate;
+   task->mPoolKey = poolKey;
+   for (int ch = 0; ch < data->NumActiveChannels(); ++ch)
+      task->mChannels.push_back(data->GetChannel(ch));
+   return task;
+}
+
+//static
+std::shared_ptr<SampleDecoder::Task> SampleDecoder::Decode(const juce::File& file, bool parallel, std::shared_ptr<ChannelBuffer> data, int sampleRate, const SamplePool::Key& poolKey)
+{
+   auto task = MakeTask(file, data, sampleRate, poolKey);
+   task->mDecodeChannels = task->mChannels;
+   task->mDecodeLength = task->mNumSamples;
+   task->mProgressTotal = task->mNumSamples;
+   StartDecoding(task, parallel);
+   return task;
+}
+
+//static
+std::shared_ptr<SampleDecoder::Task> SampleDecoder::DecodeAndConvert(const juce::File& file, bool parallel, int fileLength, int fileSampleRate, std::shared_ptr<ChannelBuffer> data, int sampleRate, const SamplePool::Key& poolKey, const juce::File& cacheFile)
+{
+   auto task = MakeTask(file, data, sampleRate, poolKey);
+   task->mFileData = std::make_unique<ChannelBuffer>(fileLength);
+   task->mFileData->SetNumActiveChannels(data->NumActiveChannels());
+   for (int ch = 0; ch < data->NumActiveChannels(); ++ch)
+      task->mDecodeChannels.push_back(task->mFileData->GetChannel(ch));
+   task->mDecodeLength = fileLength;
+   task->mFileSampleRate = fileSampleRate;
+   task->mCacheFile = cacheFile;
+   task->mNumConvertChunks = std::max((task->mNumSamples + kChunkSize - 1) / kChunkSize, 1);
+   task->mConvertChunksLeft = task->mNumConvertChunks;
+   task->mProgressTotal = fileLength + task->mNumSamples;
+   StartDecoding(task, parallel);
+   return task;
+}
+
+//static
+void SampleDecoder::StartDecoding(std::shared_ptr<Task> task, bool parallel)
+{
+   int chunkSize = parallel ? kChunkSize : std::max(task->mDecodeLength, 1);
+   int numChunks = std::max((task->mDecodeLength + chunkSize - 1) / chunkSize, 1);
+   task->mDecodeChunksLeft = numChunks;
+   task->mChunksLeft = numChunks + task->mNumConvertChunks;
+   for (int i = 0; i < numChunks; ++i) //jobs run in the order they're added, so the start of the file is ready first
+   {
+      int start = i * chunkSize;
+      int length = std::min(chunkSize, task->mDecodeLength - start);
+      GetThreadPool().addJob([task, start, length]
+                             { DecodeChunk(task, start, length); });
+   }
+}
+
+//static
+void SampleDecoder::DecodeChunk(std::shared_ptr<Task> task, int start, int length)
+{
+   std::unique_ptr<juce::AudioFormatReader> reader;
+   if (!task->mCancelled)
+      reader.reset(TheSynth->GetAudioFormatManager().createReaderFor(task->mFile)); //one reader per chunk, they can't be shared between threads
+
+   if (reader == nullptr && !task->mCancelled)
+      task->mFailed = true;
+
+   if (reader != nullptr)
+   {
+      int numChannels = (int)task->mDecodeChannels.size();
+      bool downmix = numChannels == 1 && reader->numChannels > 1;
+      juce::AudioBuffer<float> downmixBuffer;
+      if (downmix)
+         downmixBuffer.setSize(reader->numChannels, std::min(kReadBlockSize, length));
+
+      for (int pos = start; pos < start + length && !task->mCancelled; pos += kReadBlockSize)
+      {
+         int blockSize = std::min(kReadBlockSize, start + length - pos);
+         if (downmix)
+         {
+            reader->read(&downmixBuffer, 0, blockSize, pos, true, true);
+            float* dest = task->mDecodeChannels[0] + pos;
+            BufferCopy(dest, downmixBuffer.getReadPointer(0), blockSize);
+            for (int ch = 1; ch < downmixBuffer.getNumChannels(); ++ch)
+               Add(dest, downmixBuffer.getReadPointer(ch), blockSize);
+            Mult(dest, 1.0f / downmixBuffer.getNumChannels(), blockSize);
+         }
+         else
+         {
+            juce::AudioBuffer<float> dest(task->mDecodeChannels.data(), numChannels, pos, blockSize);
+            reader->read(&dest, 0, blockSize, pos, true, true);
+         }
+         task->mSamplesDecoded += blockSize;
+      }
+   }
+
+   if (task->mNumConvertChunks > 0 && --task->mDecodeChunksLeft == 0) //the whole file is in, start converting it
+   {
+      if (!task->mCancelled && !task->mFailed)
+         task->mResampler = std::make_unique<SampleResampler>(task->mFileSampleRate, task->mSampleRate);
+      for (int i = 0; i < task->mNumConvertChunks; ++i)
+      {
+         int convertStart = i * kChunkSize;
+         int convertLength = std::min(kChunkSize, task->mNumSamples - convertStart);
+         GetThreadPool().addJob([task, convertStart, convertLength]
+                                { ConvertChunk(task, convertStart, convertLength); });
+      }
+   }
+
+   task->ChunkFinished();
+}
+
+//static
+void SampleDecoder::ConvertChunk(std::shared_ptr<Task> task, int start, int length)
+{
+   if (task->mResampler != nullptr)
+   {
+      for (int pos = start; pos < start + length && !task->mCancelled; pos += kReadBlockSize)
+      {
+         int blockSize = std::min(kReadBlockSize, start + length - pos);
+         for (int ch = 0; ch < (int)task->mChannels.size(); ++ch)
+            task->mResampler->Process(task->mDecodeChannels[ch], task->mDecodeLength, task->mChannels[ch] + pos, pos, blockSize);
+         task->mSamplesDecoded += blockSize;
+      }
+   }
+
+   if (--task->mConvertChunksLeft == 0)
+   {
+      task->mFileData = nullptr; //don't need the file's own rate copy anymore
+      if (task->mResampler != nullptr && !task->mCancelled && task->mCacheFile != juce::File())
+      {
+         if (!SampleResampler::WriteCacheFile(task->mCacheFile, task->mChannels, task->mNumSamples, task->mSampleRate))
+            ofLog() << "couldn't write resampled cache file " << task->mCacheFile.getFullPathName().toStdString();
+      }
+   }
+
+   task->ChunkFinished();
+}
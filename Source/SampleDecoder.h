@@ -0,0 +1,104 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleDecoder.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SamplePool.h"
+#include "SampleResampler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "juce_core/juce_core.h"
+
+class ChannelBuffer;
+
+//decodes audio files on a pool of worker threads, straight into the ChannelBuffer that the Sample plays from.
+//the buffer starts out silent and fills in as chunks finish (earliest first), so playback can start right away.
+//uncompressed files are split into chunks that decode in parallel; compressed ones decode in order on one worker, since seeking them is slow.
+//DecodeAndConvert() decodes into a separate buffer first, and then converts that to the new rate in parallel chunks (and caches the result
+//on disk), so the buffer stays silent until the conversion gets to it.
+class SampleDecoder
+{
+public:
+   class Task
+   {
+   public:
+      void Cancel() { mCancelled = true; }
+      bool IsDone() const { return mChunksLeft == 0; }
+      bool IsPooled() const { return mPooled; } //finished without being cancelled, and handed to SamplePool
+      float GetProgress() const { return mProgressTotal > 0 ? float(mSamplesDecoded) / mProgressTotal : 1; }
+      void Wait();
+
+   private:
+      friend class SampleDecoder;
+      void ChunkFinished();
+
+      juce::File mFile;
+      std::shared_ptr<ChannelBuffer> mData;
+      std::vector<float*> mChannels; //mData's channels, allocated up front so the workers never touch mData itself
+      int mNumSamples{ 0 };
+      int mSampleRate{ 0 };
+      SamplePool::Key mPoolKey;
+      int mProgressTotal{ 0 };
+
+      //where the file decodes to. mChannels, unless we're converting, in which case it's mFileData's channels.
+      std::vector<float*> mDecodeChannels;
+      int mDecodeLength{ 0 };
+
+      //converting only
+      std::unique_ptr<ChannelBuffer> mFileData;
+      int mFileSampleRate{ 0 };
+      std::unique_ptr<SampleResampler> mResampler; //made by the last decode chunk
+      juce::File mCacheFile;
+      int mNumConvertChunks{ 0 };
+      std::atomic<int> mDecodeChunksLeft{ 0 };
+      std::atomic<int> mConvertChunksLeft{ 0 };
+
+      std::atomic<bool> mCancelled{ false };
+      std::atomic<bool> mFailed{ false };
+      std::atomic<bool> mPooled{ false };
+      std::atomic<int> mChunksLeft{ 0 };
+      std::atomic<int> mSamplesDecoded{ 0 };
+      std::mutex mDoneMutex;
+      std::condition_variable mDoneCondition;
+   };
+
+   //data must already be sized to the file and have its channel count set
+   static std::shared_ptr<Task> Decode(const juce::File& file, bool parallel, std::shared_ptr<ChannelBuffer> data, int sampleRate, const SamplePool::Key& poolKey);
+   //data must already be sized to SampleResampler::GetOutputLength() and have its channel count set. cacheFile can be empty.
+   static std::shared_ptr<Task> DecodeAndConvert(const juce::File& file, bool parallel, int fileLength, int fileSampleRate, std::shared_ptr<ChannelBuffer> data, int sampleRate, const SamplePool::Key& poolKey, const juce::File& cacheFile);
+
+private:
+   static std::shared_ptr<Task> MakeTask(const juce::File& file, std::shared_ptr<ChannelBuffer> data, int sampleRate, const SamplePool::Key& poolKey);
+   static void StartDecoding(std::shared_ptr<Task> task, bool parallel);
+   static void DecodeChunk(std::shared_ptr<Task> task, int start, int length);
+   static void ConvertChunk(std::shared_ptr<Task> task, int start, int length);
+};
@@ -151,6 +151,17 @@ void SampleFinder::DrawModule()
          mSampleDrawer.SetDimensions(900, 310);
          mSampleDrawer.SetRange(mZoomStart, mZoomEnd);
          mSampleDrawer.Draw((int)mPlayhead);
+         auto analysis = mAnalysis != nullptr ? mAnalysis->GetResult() : nullptr;
+         if (analysis != nullptr)
+         {
+            for (int onset : analysis->mOnsets)
+            {
+               if (onset >= mZoomStart && onset <= mZoomEnd)
+                  mSampleDrawer.DrawLine(onset, ofColor(255, 255, 255, 60));
+            }
+            if (analysis->mTempo > 0)
+               DrawTextNormal("detected tempo: " + ofToString(analysis->mTempo, 1), 215, 70);
+         }
          mSampleDrawer.DrawLine(mClipStart, ofColor::red);
          mSampleDrawer.DrawLine(mClipEnd, ofColor::red);
 
@@ -196,6 +207,7 @@ void SampleFinder::FilesDropped(std::vector<std::string> files, int x, int y)
    mSample->Reset();
 
    mSample->Read(files[0].c_str());
+   mAnalysis = SampleAnalysis::Analyze(mSample);
 
    mClipStart = 0;
    mClipEnd = mSample->LengthInSamples();
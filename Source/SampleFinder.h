@@ -33,6 +33,7 @@
 #include "DropdownList.h"
 #include "ClickButton.h"
 #include "SampleDrawer.h"
+#include "SampleAnalysis.h"
 
 class Sample;
 
@@ -111,6 +112,7 @@ private:
    ClickButton* mDoubleLengthButton{ nullptr };
    ClickButton* mHalveLengthButton{ nullptr };
    SampleDrawer mSampleDrawer;
+   std::shared_ptr<SampleAnalysis::Task> mAnalysis;
    bool mReverse{ false };
    Checkbox* mReverseCheckbox{ nullptr };
 };
@@ -0,0 +1,472 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleIndex.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+
+#include "SampleIndex.h"
+#include "ModularSynth.h"
+#include "FileStream.h"
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+namespace
+{
+   const int kIndexFileVersion = 1;
+   const int kSaveIntervalMs = 30000; //while scanning, so a crash doesn't lose everything
+
+   std::string GetChildPrefix(const std::string& dir)
+   {
+      if (!dir.empty() && dir.back() == '/') //filesystem roots
+         return dir;
+      return dir + "/";
+   }
+
+   bool StartsWith(const std::string& text, const std::string& prefix)
+   {
+      return text.compare(0, prefix.size(), prefix) == 0;
+   }
+}
+
+//static
+std::shared_ptr<SampleIndex> SampleIndex::Acquire()
+{
+   static std::mutex sMutex;
+   static std::weak_ptr<SampleIndex> sIndex;
+
+   std::lock_guard<std::mutex> lock(sMutex);
+   std::shared_ptr<SampleIndex> index = sIndex.lock();
+   if (index == nullptr)
+   {
+      index.reset(new SampleIndex());
+      sIndex = index;
+      index->startThread(juce::Thread::Priority::background);
+   }
+   return index;
+}
+
+SampleIndex::SampleIndex()
+: juce::Thread("sample index")
+{
+   mWildcards.addTokens(TheSynth->GetAudioFormatManager().getWildcardForAllFormats(), ";,", "\"'");
+   mWildcards.trim();
+   mWildcards.removeEmptyStrings();
+}
+
+SampleIndex::~SampleIndex()
+{
+   //scanning and saving both check threadShouldExit() often, so this doesn't take long, and we never need to kill the thread mid-write
+   signalThreadShouldExit();
+   notify();
+   stopThread(-1);
+
+   //the index thread abandons a save if it's told to stop, so the final one happens here, from whoever let go of the index last
+   if (mDirty)
+      Save();
+}
+
+//static
+std::string SampleIndex::GetKey(const juce::File& file)
+{
+   return file.getFullPathName().replace(GetPathSeparator(), "/").toStdString();
+}
+
+//static
+std::string SampleIndex::GetIndexPath()
+{
+   return ofToDataPath("cache/sampleindex.dat");
+}
+
+void SampleIndex::AddRoot(const std::string& dir)
+{
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mVisited.clear(); //a fresh walk, so look at everything again
+      mJobs.push_back({ dir, true, false, GetKey(juce::File(dir).getLinkedTarget()) });
+   }
+   notify();
+}
+
+void SampleIndex::RequestScan(const std::string& dir)
+{
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mJobs.push_front({ dir, false, true });
+   }
+   notify();
+}
+
+bool SampleIndex::GetListing(const std::string& dir, std::vector<Entry>& listing) const
+{
+   std::shared_ptr<const Directory> directory;
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto iter = mDirectories.find(dir);
+      if (iter == mDirectories.end())
+         return false;
+      directory = iter->second;
+   }
+
+   listing.insert(listing.end(), directory->mEntries.begin(), directory->mEntries.end());
+   return true;
+}
+
+void SampleIndex::Search(const std::string& dir, const std::string& text, std::vector<Entry>& results, int maxResults) const
+{
+   std::string searchText = juce::String(text).toLowerCase().toStdString();
+   std::string prefix = GetChildPrefix(dir);
+
+   std::vector<std::shared_ptr<const Directory>> directories;
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto iter = mDirectories.find(dir);
+      if (iter != mDirectories.end())
+         directories.push_back(iter->second);
+      for (iter = mDirectories.lower_bound(prefix); iter != mDirectories.end() && StartsWith(iter->first, prefix); ++iter)
+         directories.push_back(iter->second);
+   }
+
+   for (const auto& directory : directories)
+   {
+      for (const auto& entry : directory->mEntries)
+      {
+         if (entry.mSearchName.find(searchText) != std::string::npos)
+         {
+            results.push_back(entry);
+            if ((int)results.size() >= maxResults)
+               return;
+         }
+      }
+   }
+}
+
+int SampleIndex::GetNumPendingDirectories() const
+{
+   std::lock_guard<std::mutex> lock(mMutex);
+   return (int)mJobs.size();
+}
+
+void SampleIndex::run()
+{
+   Load();
+
+   juce::uint32 lastSaveTime = juce::Time::getMillisecondCounter();
+   while (!threadShouldExit())
+   {
+      Job job;
+      bool hasJob = false;
+      {
+         std::lock_guard<std::mutex> lock(mMutex);
+         if (!mJobs.empty())
+         {
+            job = mJobs.front();
+            mJobs.pop_front();
+            hasJob = true;
+         }
+      }
+
+      if (hasJob)
+         ScanDirectory(job);
+
+      if (mDirty && (!hasJob || juce::Time::getMillisecondCounter() - lastSaveTime > kSaveIntervalMs))
+      {
+         Save();
+         lastSaveTime = juce::Time::getMillisecondCounter();
+      }
+
+      if (!hasJob)
+         wait(-1); //until there's something new to scan, or we're stopping
+   }
+}
+
+void SampleIndex::ScanDirectory(const Job& job)
+{
+   juce::File dir(job.mPath);
+   std::shared_ptr<const Directory> existing;
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto iter = mDirectories.find(job.mPath);
+      if (iter != mDirectories.end())
+         existing = iter->second;
+   }
+
+   if (!dir.isDirectory())
+   {
+      if (existing != nullptr)
+      {
+         std::lock_guard<std::mutex> lock(mMutex);
+         mDirectories.erase(job.mPath);
+         ++mGeneration;
+         mDirty = true;
+      }
+      return;
+   }
+
+   double modificationTime = (double)dir.getLastModificationTime().toMilliseconds();
+   std::shared_ptr<const Directory> result = existing;
+   if (existing == nullptr || existing->mModificationTime != modificationTime || (job.mCheckFiles && HaveFilesChanged(*existing)))
+   {
+      std::map<std::string, const Entry*> previous;
+      if (existing != nullptr)
+      {
+         for (const auto& entry : existing->mEntries)
+            previous[entry.mPath] = &entry;
+      }
+
+      auto directory = std::make_shared<Directory>();
+      directory->mModificationTime = modificationTime;
+      for (const auto& child : juce::RangedDirectoryIterator(dir, false, "*", juce::File::findFilesAndDirectories | juce::File::ignoreHiddenFiles))
+      {
+         if (threadShouldExit())
+            return;
+
+         const juce::File& file = child.getFile();
+         if (!child.isDirectory() && !IsAudioFile(file.getFileName()))
+            continue;
+
+         Entry entry;
+         entry.mPath = GetKey(file);
+         entry.mIsDirectory = child.isDirectory();
+         if (!entry.mIsDirectory)
+         {
+            entry.mModificationTime = (double)child.getModificationTime().toMilliseconds();
+            entry.mSize = (double)child.getFileSize();
+            auto iter = previous.find(entry.mPath);
+            if (iter != previous.end() && iter->second->mModificationTime == entry.mModificationTime && iter->second->mSize == entry.mSize)
+               entry = *iter->second;
+            else if (!ReadInfo(file, entry))
+               return; //stopping
+         }
+         entry.mSearchName = file.getFileName().toLowerCase().toStdString();
+         directory->mEntries.push_back(entry);
+         previous.erase(entry.mPath);
+      }
+
+      std::lock_guard<std::mutex> lock(mMutex);
+      for (const auto& removed : previous) //forget about any subdirectories that have gone
+      {
+         if (removed.second->mIsDirectory)
+         {
+            std::string prefix = GetChildPrefix(removed.first);
+            mDirectories.erase(removed.first);
+            auto iter = mDirectories.lower_bound(prefix);
+            while (iter != mDirectories.end() && StartsWith(iter->first, prefix))
+               iter = mDirectories.erase(iter);
+         }
+      }
+      mDirectories[job.mPath] = directory;
+      ++mGeneration;
+      mDirty = true;
+      result = directory;
+   }
+
+   if (job.mRecursive)
+   {
+      //symlinks can make a cycle, so only walk into each real directory once, wherever it's linked from
+      std::vector<Job> children;
+      std::string childPrefix = GetChildPrefix(job.mCanonicalPath);
+      for (const auto& entry : result->mEntries)
+      {
+         if (entry.mIsDirectory)
+         {
+            juce::File child(entry.mPath);
+            std::string canonicalPath = child.isSymbolicLink() ? GetKey(child.getLinkedTarget()) : childPrefix + child.getFileName().toStdString();
+            children.push_back({ entry.mPath, true, false, canonicalPath });
+         }
+      }
+
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (mVisited.insert(job.mCanonicalPath).second)
+      {
+         for (auto& child : children)
+            mJobs.push_back(std::move(child));
+      }
+   }
+}
+
+bool SampleIndex::HaveFilesChanged(const Directory& directory)
+{
+   for (const auto& entry : directory.mEntries)
+   {
+      if (threadShouldExit())
+         return false;
+
+      if (entry.mIsDirectory)
+         continue;
+      juce::File file(entry.mPath);
+      if ((double)file.getLastModificationTime().toMilliseconds() != entry.mModificationTime || (double)file.getSize() != entry.mSize)
+         return true;
+   }
+   return false;
+}
+
+//returns false if we're stopping
+bool SampleIndex::ReadInfo(const juce::File& file, Entry& entry)
+{
+   std::unique_ptr<juce::AudioFormatReader> reader(TheSynth->GetAudioFormatManager().createReaderFor(file));
+   if (reader == nullptr)
+      return true; //still list it, like the browser always has, but with no info
+
+   entry.mLengthInSamples = (int)reader->lengthInSamples;
+   entry.mNumChannels = (int)reader->numChannels;
+   entry.mSampleRate = (int)reader->sampleRate;
+
+   int numChannelsToRead = std::min((int)reader->numChannels, 2);
+   for (int i = 0; i < kThumbnailSize && entry.mLengthInSamples > 0; ++i)
+   {
+      if (threadShouldExit())
+         return false;
+
+      juce::int64 start = reader->lengthInSamples * i / kThumbnailSize;
+      juce::int64 end = reader->lengthInSamples * (i + 1) / kThumbnailSize;
+      juce::Range<float> levels[2];
+      reader->readMaxLevels(start, end - start, levels, numChannelsToRead);
+      float peak = 0;
+      for (int ch = 0; ch < numChannelsToRead; ++ch)
+         peak = std::max(peak, std::max(-levels[ch].getStart(), levels[ch].getEnd()));
+      entry.mThumbnail[i] = (uint8_t)(ofClamp(peak, 0, 1) * 255);
+   }
+
+   return true;
+}
+
+bool SampleIndex::IsAudioFile(const juce::String& fileName) const
+{
+   for (const auto& wildcard : mWildcards)
+   {
+      if (fileName.matchesWildcard(wildcard, true))
+         return true;
+   }
+   return false;
+}
+
+void SampleIndex::Load()
+{
+   juce::File indexFile(GetIndexPath());
+   if (!indexFile.existsAsFile())
+      return;
+
+   FileStreamIn in(indexFile.getFullPathName().toStdString());
+   if (!in.OpenedOk())
+      return;
+   int version = -1;
+   in >> version;
+   if (version != kIndexFileVersion)
+      return; //just build it again
+
+   //a truncated or corrupt index shouldn't make us allocate more than the file could possibly hold. if any count doesn't fit in
+   //what's left of the file, ignore the whole thing, and it'll be built again and overwritten.
+   const juce::int64 fileSize = indexFile.getSize();
+   auto fits = [&in, fileSize](int count, int minBytesEach)
+   {
+      return count >= 0 && (juce::int64)count * minBytesEach <= fileSize - in.GetFilePosition();
+   };
+   std::map<std::string, std::shared_ptr<const Directory>> directories;
+   int numDirectories = -1;
+   in >> numDirectories;
+   if (!fits(numDirectories, 1))
+   {
+      ofLog() << "sample index is corrupt, rebuilding it";
+      return;
+   }
+   for (int i = 0; i < numDirectories && !in.Eof(); ++i)
+   {
+      std::string path;
+      auto directory = std::make_shared<Directory>();
+      int numEntries = -1;
+      in >> path;
+      in >> directory->mModificationTime;
+      in >> numEntries;
+      if (!fits(numEntries, kThumbnailSize)) //every entry at least has its thumbnail
+      {
+         ofLog() << "sample index is corrupt, rebuilding it";
+         return;
+      }
+      directory->mEntries.resize(numEntries);
+      for (auto& entry : directory->mEntries)
+      {
+         in >> entry.mPath;
+         in >> entry.mIsDirectory;
+         in >> entry.mModificationTime;
+         in >> entry.mSize;
+         in >> entry.mLengthInSamples;
+         in >> entry.mNumChannels;
+         in >> entry.mSampleRate;
+         in.ReadGeneric(entry.mThumbnail.data(), kThumbnailSize);
+         entry.mSearchName = juce::File(entry.mPath).getFileName().toLowerCase().toStdString();
+      }
+      directories[path] = directory;
+   }
+
+   std::lock_guard<std::mutex> lock(mMutex);
+   for (auto& directory : directories)
+      mDirectories.insert(directory); //anything scanned while we were loading is newer
+   ++mGeneration;
+}
+
+void SampleIndex::Save()
+{
+   bool onIndexThread = isThisTheCurrentThread();
+   mDirty = false;
+
+   std::map<std::string, std::shared_ptr<const Directory>> directories;
+   {
+      std::lock_guard<std::mutex> lock(mMutex);
+      directories = mDirectories;
+   }
+
+   juce::File indexFile(GetIndexPath());
+   indexFile.getParentDirectory().createDirectory();
+   juce::TemporaryFile tempFile(indexFile); //so a crash while saving doesn't leave half an index
+   {
+      FileStreamOut out(tempFile.getFile().getFullPathName().toStdString());
+      out << kIndexFileVersion;
+      out << (int)directories.size();
+      for (const auto& directory : directories)
+      {
+         if (onIndexThread && threadShouldExit())
+         {
+            mDirty = true; //leave the old index in place, and let the destructor save it
+            return;
+         }
+
+         out << directory.first;
+         out << directory.second->mModificationTime;
+         out << (int)directory.second->mEntries.size();
+         for (const auto& entry : directory.second->mEntries)
+         {
+            out << entry.mPath;
+            out << entry.mIsDirectory;
+            out << entry.mModificationTime;
+            out << entry.mSize;
+            out << entry.mLengthInSamples;
+            out << entry.mNumChannels;
+            out << entry.mSampleRate;
+            out.WriteGeneric(entry.mThumbnail.data(), kThumbnailSize);
+         }
+      }
+   }
+   tempFile.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,115 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleIndex.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "juce_core/juce_core.h"
+
+//a persistent index of sample directories, for browsing big libraries (or ones on slow network drives) without touching the disk on the
+//main thread. a background thread walks the roots it's given and keeps a listing of each directory, plus each file's length, channels,
+//rate and a waveform thumbnail. it's saved to disk, and a directory is only listed again once its modification time changes (or, for the
+//one being looked at, once any of its files' do), and a file only read again once its modification time or size does.
+class SampleIndex : private juce::Thread
+{
+public:
+   static constexpr int kThumbnailSize = 64;
+
+   struct Entry
+   {
+      std::string mPath; //full path, with forward slashes
+      std::string mSearchName; //lowercase file name
+      bool mIsDirectory{ false };
+      double mModificationTime{ 0 };
+      double mSize{ 0 };
+      int mLengthInSamples{ 0 };
+      int mNumChannels{ 0 };
+      int mSampleRate{ 0 };
+      std::array<uint8_t, kThumbnailSize> mThumbnail{}; //peak level of each slice of the file, 0-255
+   };
+
+   //shared by every samplebrowser, and saved when the last one lets go of it
+   static std::shared_ptr<SampleIndex> Acquire();
+   ~SampleIndex();
+
+   static std::string GetKey(const juce::File& file);
+
+   void AddRoot(const std::string& dir); //index everything under this directory, eventually
+   void RequestScan(const std::string& dir); //(re)scan this directory before anything else, for when it's being looked at
+   bool GetListing(const std::string& dir, std::vector<Entry>& listing) const; //false if it hasn't been scanned yet
+   void Search(const std::string& dir, const std::string& text, std::vector<Entry>& results, int maxResults) const; //everything indexed under dir
+   int GetGeneration() const { return mGeneration; } //changes whenever any listing does
+   int GetNumPendingDirectories() const;
+
+private:
+   struct Directory
+   {
+      double mModificationTime{ 0 };
+      std::vector<Entry> mEntries;
+   };
+
+   struct Job
+   {
+      std::string mPath;
+      bool mRecursive{ false };
+      bool mCheckFiles{ false }; //stat the files even if the directory hasn't changed, since editing a file in place doesn't touch it
+      std::string mCanonicalPath; //recursive jobs only, mPath with any symlinks along the way resolved
+   };
+
+   SampleIndex();
+
+   //juce::Thread
+   void run() override;
+
+   void ScanDirectory(const Job& job);
+   bool HaveFilesChanged(const Directory& directory);
+   bool ReadInfo(const juce::File& file, Entry& entry);
+   bool IsAudioFile(const juce::String& fileName) const;
+   void Load();
+   void Save();
+
+   static std::string GetIndexPath();
+
+   mutable std::mutex mMutex;
+   std::map<std::string, std::shared_ptr<const Directory>> mDirectories; //subdirectories sort right after their parent, so a prefix is a contiguous range
+   std::deque<Job> mJobs;
+   std::set<std::string> mVisited; //canonical paths of directories already walked into during the current recursive scan
+   std::atomic<int> mGeneration{ 0 };
+   std::atomic<bool> mDirty{ false };
+   juce::StringArray mWildcards;
+};
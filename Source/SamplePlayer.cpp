@@ -346,6 +346,7 @@ void SamplePlayer::Process(double time)
          mPlaySpeed = ofLerp(mPlaySpeed, mSpeed * mCuePointSpeed, kBlendSpeed);
       }
       mSample->SetRate(mPlaySpeed);
+      mSample->SetInterpolationQuality(mInterpolationQuality);
 
       gWorkChannelBuffer.SetNumActiveChannels(mSample->NumChannels());
 
@@ -353,11 +354,10 @@ void SamplePlayer::Process(double time)
       {
          if (mSample->ConsumeData(time, &gWorkChannelBuffer, bufferSize, true))
          {
+            mAdsr.Render(time, gInvSampleRateMs, gWorkBuffer, bufferSize);
+            Mult(gWorkBuffer, volSq, bufferSize);
             for (int ch = 0; ch < gWorkChannelBuffer.NumActiveChannels(); ++ch)
-            {
-               for (int i = 0; i < bufferSize; ++i)
-                  gWorkChannelBuffer.GetChannel(ch)[i] *= volSq * mAdsr.Value(time + i * gInvSampleRateMs);
-            }
+               Mult(gWorkChannelBuffer.GetChannel(ch), gWorkBuffer, bufferSize);
          }
          else
          {
@@ -565,10 +565,10 @@ void SamplePlayer::ButtonClicked(ClickButton* button, double time)
 
       Sample* sample = new Sample();
       sample->Create(GetZoomEndSample() - GetZoomStartSample());
-      sample->Data()->SetNumActiveChannels(mSample->NumChannels());
+      sample->EditData()->SetNumActiveChannels(mSample->NumChannels());
       for (int ch = 0; ch < mSample->NumChannels(); ++ch)
       {
-         float* sampleData = sample->Data()->GetChannel(ch);
+         float* sampleData = sample->EditData()->GetChannel(ch);
          for (int i = 0; i < sample->LengthInSamples(); ++i)
             sampleData[i] = mSample->Data()->GetChannel(ch)[i + GetZoomStartSample()];
       }
@@ -770,7 +770,7 @@ void SamplePlayer::FillData(std::vector<float> data)
 {
    Sample* sample = new Sample();
    sample->Create((int)data.size());
-   float* sampleData = sample->Data()->GetChannel(0);
+   float* sampleData = sample->EditData()->GetChannel(0);
    for (size_t i = 0; i < data.size(); ++i)
       sampleData[i] = data[i];
    UpdateSample(sample, true);
@@ -823,14 +823,10 @@ ChannelBuffer* SamplePlayer::GetCueSampleData(int cueIndex)
       BufferCopy(data->GetChannel(ch), mSample->Data()->GetChannel(ch) + startSamples, lengthSamplesSrc);
    }*/
 
+   //offline render, so we can afford the better kernel here. read from the whole sample, so the taps near the cue's edges see the
+   //audio on either side of it, like playback does, rather than wrapping around inside the cue
    for (int ch = 0; ch < data->NumActiveChannels(); ++ch)
-   {
-      for (int i = 0; i < lengthSamplesDest; ++i)
-      {
-         float offset = i * speed * mSample->GetSampleRateRatio();
-         data->GetChannel(ch)[i] = GetInterpolatedSample(offset, mSample->Data()->GetChannel(ch) + startSamples, lengthSamplesSrc);
-      }
-   }
+      Interpolation::ReadBlockClamped(startSamples, speed * mSample->GetSampleRateRatio(), mSample->Data()->GetChannel(ch), mSample->Data()->BufferSize(), data->GetChannel(ch), lengthSamplesDest, InterpolationQuality::Sinc);
 
    return data;
 }
@@ -1355,7 +1351,7 @@ void SamplePlayer::StopRecording()
 
       Sample* sample = new Sample();
       sample->Create(mRecordingLength);
-      ChannelBuffer* data = sample->Data();
+      ChannelBuffer* data = sample->EditData();
       int channelCount = mRecordChunks[0]->NumActiveChannels();
       data->SetNumActiveChannels(channelCount);
 
@@ -1390,6 +1386,10 @@ void SamplePlayer::LoadLayout(const ofxJSONElement& moduleInfo)
    mModuleSaveData.LoadString("target", moduleInfo);
    mModuleSaveData.LoadBool("show_youtube_process_output", moduleInfo, false);
 
+   EnumMap interpolationMap;
+   Interpolation::FillEnumMap(interpolationMap);
+   mModuleSaveData.LoadEnum<int>("interpolation", moduleInfo, (int)InterpolationQuality::Linear, nullptr, &interpolationMap);
+
    SetUpFromSaveData();
 }
 
@@ -1400,6 +1400,7 @@ void SamplePlayer::SaveLayout(ofxJSONElement& moduleInfo)
 void SamplePlayer::SetUpFromSaveData()
 {
    SetTarget(TheSynth->FindModule(mModuleSaveData.GetString("target")));
+   mInterpolationQuality = mModuleSaveData.GetEnum<InterpolationQuality>("interpolation");
 }
 
 void SamplePlayer::SaveState(FileStreamOut& out)
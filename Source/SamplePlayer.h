@@ -40,6 +40,7 @@
 #include "GateEffect.h"
 #include "IPulseReceiver.h"
 #include "SwitchAndRamp.h"
+#include "Interpolation.h"
 
 #include "juce_osc/juce_osc.h"
 
@@ -142,6 +143,7 @@ private:
    float mSpeed{ 1 };
    float mPlaySpeed{ 1 };
    float mCuePointSpeed{ 1 };
+   InterpolationQuality mInterpolationQuality{ InterpolationQuality::Linear };
    FloatSlider* mSpeedSlider{ nullptr };
    ClickButton* mPlayButton{ nullptr };
    ClickButton* mPauseButton{ nullptr };
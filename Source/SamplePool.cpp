@@ -0,0 +1,91 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SamplePool.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#include "SamplePool.h"
+#include "ChannelBuffer.h"
+
+#include <tuple>
+
+#include "juce_core/juce_core.h"
+
+std::mutex SamplePool::sMutex;
+std::map<SamplePool::Key, SamplePool::Entry> SamplePool::sEntries;
+
+bool SamplePool::Key::operator<(const Key& other) const
+{
+   return std::tie(mPath, mModificationTime, mSize, mMono, mSampleRate) < std::tie(other.mPath, other.mModificationTime, other.mSize, other.mMono, other.mSampleRate);
+}
+
+//static
+SamplePool::Key SamplePool::MakeKey(const juce::File& file, bool mono, int sampleRate /*= 0*/)
+{
+   //modification time and size, so that a file that's been overwritten since gets read again
+   Key key;
+   key.mPath = file.getFullPathName().toStdString();
+   key.mModificationTime = file.getLastModificationTime().toMilliseconds();
+   key.mSize = file.getSize();
+   key.mMono = mono;
+   key.mSampleRate = sampleRate;
+   return key;
+}
+
+//static
+std::shared_ptr<ChannelBuffer> SamplePool::Find(const Key& key, int& sampleRate)
+{
+   std::lock_guard<std::mutex> lock(sMutex);
+   auto iter = sEntries.find(key);
+   if (iter == sEntries.end())
+      return nullptr;
+
+   std::shared_ptr<ChannelBuffer> data = iter->second.mData.lock();
+   if (data == nullptr)
+   {
+      sEntries.erase(iter);
+      return nullptr;
+   }
+
+   sampleRate = iter->second.mSampleRate;
+   return data;
+}
+
+//static
+void SamplePool::Add(const Key& key, std::shared_ptr<ChannelBuffer> data, int sampleRate)
+{
+   std::lock_guard<std::mutex> lock(sMutex);
+
+   for (auto iter = sEntries.begin(); iter != sEntries.end();) //clean out anything nobody's using anymore
+   {
+      if (iter->second.mData.expired())
+         iter = sEntries.erase(iter);
+      else
+         ++iter;
+   }
+
+   Entry& entry = sEntries[key];
+   entry.mData = data;
+   entry.mSampleRate = sampleRate;
+}
@@ -0,0 +1,73 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SamplePool.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class ChannelBuffer;
+
+namespace juce
+{
+   class File;
+}
+
+//decoded audio for every file that a Sample has read, so that reading the same file again (the same kit in several drumplayers, switching
+//back to a kit) shares the data that's already in memory instead of decoding another copy.
+//the pool only holds weak references, data goes away once the last Sample using it does. pooled data must never be written to, see
+//Sample::EditData().
+class SamplePool
+{
+public:
+   struct Key
+   {
+      std::string mPath; //full path
+      int64_t mModificationTime{ 0 };
+      int64_t mSize{ 0 };
+      bool mMono{ false };
+      int mSampleRate{ 0 }; //what rate the data was converted to on load, 0 if it's at the file's own rate
+
+      bool operator<(const Key& other) const;
+   };
+
+   static Key MakeKey(const juce::File& file, bool mono, int sampleRate = 0);
+   static std::shared_ptr<ChannelBuffer> Find(const Key& key, int& sampleRate);
+   static void Add(const Key& key, std::shared_ptr<ChannelBuffer> data, int sampleRate);
+
+private:
+   struct Entry
+   {
+      std::weak_ptr<ChannelBuffer> mData;
+      int mSampleRate{ 0 };
+   };
+
+   static std::mutex sMutex;
+   static std::map<Key, Entry> sEntries;
+};
@@ -0,0 +1,145 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleResampler.cpp
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+
+#include "SampleResampler.h"
+#include "SynthGlobals.h"
+
+#include "juce_audio_formats/juce_audio_formats.h"
+#include "juce_cryptography/juce_cryptography.h"
+
+namespace
+{
+   const int kHalfLength = 32; //zero crossings on each side of the kernel, at the lower of the two rates
+   const int kPhasesPerSample = 512;
+   const double kPassband = .95; //fraction of the lower nyquist that's kept, the rest is transition band
+   const double kKaiserBeta = 10; //around -100dB stopband
+
+   double BesselI0(double x)
+   {
+      double sum = 1;
+      double term = 1;
+      for (int k = 1; k < 50; ++k)
+      {
+         term *= (x / (2 * k)) * (x / (2 * k));
+         sum += term;
+         if (term < sum * 1e-12)
+            break;
+      }
+      return sum;
+   }
+}
+
+SampleResampler::SampleResampler(int inputSampleRate, int outputSampleRate)
+: mStep(double(inputSampleRate) / outputSampleRate)
+{
+   double cutoff = std::min(1.0, 1 / mStep) * kPassband; //relative to the input nyquist
+   mHalfWidth = (int)ceil(kHalfLength / cutoff);
+
+   mTable.resize(mHalfWidth * kPhasesPerSample + 2, 0); //one past the end, so lookups at the edge can interpolate towards zero
+   for (int i = 0; i < mHalfWidth * kPhasesPerSample; ++i)
+   {
+      double x = double(i) / kPhasesPerSample;
+      double t = PI * cutoff * x;
+      double sinc = (i == 0) ? 1 : sin(t) / t;
+      double r = x / mHalfWidth;
+      double window = BesselI0(kKaiserBeta * sqrt(1 - r * r)) / BesselI0(kKaiserBeta);
+      mTable[i] = float(cutoff * sinc * window);
+   }
+
+   //normalize to unity gain at dc
+   double sum = mTable[0];
+   for (int k = 1; k < mHalfWidth; ++k)
+      sum += 2 * mTable[k * kPhasesPerSample];
+   for (auto& tap : mTable)
+      tap = float(tap / sum);
+}
+
+//static
+int SampleResampler::GetOutputLength(int inputLength, int inputSampleRate, int outputSampleRate)
+{
+   return (int)((int64_t(inputLength) * outputSampleRate + inputSampleRate - 1) / inputSampleRate);
+}
+
+void SampleResampler::Process(const float* input, int inputLength, float* output, int outputStart, int outputLength) const
+{
+   const float* table = mTable.data();
+   for (int n = 0; n < outputLength; ++n)
+   {
+      double pos = (outputStart + n) * mStep;
+      int center = (int)pos;
+      double frac = pos - center;
+
+      //taps from center-mHalfWidth+1 to center+mHalfWidth, clipped to the input
+      int first = std::max(center - mHalfWidth + 1, 0);
+      int last = std::min(center + mHalfWidth, inputLength - 1);
+
+      float sum = 0;
+      for (int i = first; i <= last; ++i)
+      {
+         double tablePos = fabs(i - pos) * kPhasesPerSample;
+         int index = (int)tablePos;
+         float a = float(tablePos - index);
+         sum += input[i] * (table[index] + a * (table[index + 1] - table[index]));
+      }
+      output[n] = sum;
+   }
+}
+
+//static
+juce::File SampleResampler::GetCacheFile(const SamplePool::Key& key)
+{
+   juce::String id;
+   id << key.mPath << "|" << key.mModificationTime << "|" << key.mSize << "|" << (key.mMono ? 1 : 0) << "|" << key.mSampleRate;
+   juce::String hash = juce::MD5(id.toUTF8()).toHexString();
+   return juce::File(ofToDataPath("cache/resampled/" + hash.toStdString() + ".wav"));
+}
+
+//static
+bool SampleResampler::WriteCacheFile(const juce::File& file, const std::vector<float*>& channels, int numSamples, int sampleRate)
+{
+   file.getParentDirectory().createDirectory();
+
+   //write it all out before it shows up under its real name, so nothing ever reads half a file
+   juce::TemporaryFile tempFile(file);
+   {
+      auto outputTo = tempFile.getFile().createOutputStream();
+      if (outputTo == nullptr)
+         return false;
+
+      juce::WavAudioFormat wavFormat;
+      std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(outputTo.get(), sampleRate, (unsigned int)channels.size(), 32, {}, 0)); //32 bit float, so it's lossless
+      if (writer == nullptr)
+         return false;
+      outputTo.release(); //the writer owns it now
+
+      if (!writer->writeFromFloatArrays(channels.data(), (int)channels.size(), numSamples))
+         return false;
+   }
+
+   return tempFile.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,62 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleResampler.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+#include "SamplePool.h"
+
+#include <vector>
+
+namespace juce
+{
+   class File;
+}
+
+//band-limited sample rate conversion for whole files, for converting samples once when they load instead of interpolating every time
+//they play. a kaiser-windowed sinc, read from a table with linear interpolation between phases, so it handles any pair of rates.
+//when going down in rate, the kernel stretches to filter out everything above the new nyquist.
+class SampleResampler
+{
+public:
+   SampleResampler(int inputSampleRate, int outputSampleRate);
+
+   static int GetOutputLength(int inputLength, int inputSampleRate, int outputSampleRate);
+
+   //writes output samples [outputStart, outputStart + outputLength) of the converted input. anything before or after the input is silence.
+   //doesn't change any state, so several threads can each do a range.
+   void Process(const float* input, int inputLength, float* output, int outputStart, int outputLength) const;
+
+   //where the converted copy of a file gets cached on disk, keyed on the file (path, modification time and size), mono and target rate
+   static juce::File GetCacheFile(const SamplePool::Key& key);
+   static bool WriteCacheFile(const juce::File& file, const std::vector<float*>& channels, int numSamples, int sampleRate);
+
+private:
+   double mStep{ 1 }; //input samples per output sample
+   int mHalfWidth{ 0 }; //kernel half width, in input samples
+   std::vector<float> mTable; //kernel from 0 to mHalfWidth, kPhasesPerSample entries per input sample
+};
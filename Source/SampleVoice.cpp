@@ -54,19 +54,22 @@ bool SampleVoice::Process(double time, ChannelBuffer* out, int oversampling)
       return false;
 
    float volSq = mVoiceParams->mVol * mVoiceParams->mVol;
+   ::ADSR::Renderer adsr(mAdsr, time, gInvSampleRateMs);
 
    for (int pos = 0; pos < out->BufferSize(); ++pos)
    {
       if (mOwner)
          mOwner->ComputeSliders(pos);
 
+      float adsrVal = adsr.Next();
+
       int stopSample = mVoiceParams->mSample->LengthInSamples();
       if (mVoiceParams->mStopSample != -1)
          stopSample = mVoiceParams->mStopSample;
 
       int jumpFrom = -1;
       int jumpTo = -1;
-      bool isSustaining = !mAdsr.IsDone(time);
+      bool isSustaining = !adsr.IsDone();
       if (isSustaining && mVoiceParams->mSustainLoopStart != -1 && mVoiceParams->mSustainLoopEnd != -1)
       {
          jumpFrom = mVoiceParams->mSustainLoopEnd;
@@ -81,7 +84,7 @@ bool SampleVoice::Process(double time, ChannelBuffer* out, int oversampling)
          for (int i = 0; i < 2; ++i)
          {
             int ch = MIN(i, mVoiceParams->mSample->Data()->NumActiveChannels() - 1);
-            float sample = GetInterpolatedSample(mPos, mVoiceParams->mSample->Data()->GetChannel(ch), mVoiceParams->mSample->LengthInSamples()) * mAdsr.Value(time) * volSq;
+            float sample = GetInterpolatedSample(mPos, mVoiceParams->mSample->Data()->GetChannel(ch), mVoiceParams->mSample->LengthInSamples()) * adsrVal * volSq;
             float pan = i == 0 ? GetLeftPanGain(GetPan()) : GetRightPanGain(GetPan());
             out->GetChannel(i)[pos] += sample * pan;
          }
@@ -91,8 +94,6 @@ bool SampleVoice::Process(double time, ChannelBuffer* out, int oversampling)
          if (jumpFrom != -1 && mPos >= jumpFrom)
             mPos += (jumpTo - jumpFrom);
       }
-
-      time += gInvSampleRateMs;
    }
 
    return true;
@@ -30,6 +30,7 @@
 #include "ofxJSONElement.h"
 #include "ModularSynth.h"
 #include "Sample.h"
+#include "SampleAnalysis.h"
 #include "Profiler.h"
 #include "Scale.h"
 #include "UIControlMacros.h"
@@ -106,18 +107,19 @@ void Sampler::Process(double time)
 
    mWriteBuffer.Clear();
 
-   if (mRecording)
+   if (mRecording && mRecordData != nullptr)
    {
+      float* recordData = mRecordData;
       for (int i = 0; i < gBufferSize; ++i)
       {
          //if we've already started recording, or if it's a new recording and there's sound
          if (mRecordPos > 0 || fabsf(GetBuffer()->GetChannel(0)[i]) > mThresh)
          {
-            mSample.Data()->GetChannel(0)[mRecordPos] = GetBuffer()->GetChannel(0)[i];
+            recordData[mRecordPos] = GetBuffer()->GetChannel(0)[i];
             if (mPassthrough)
             {
                for (int ch = 0; ch < mWriteBuffer.NumActiveChannels(); ++ch)
-                  mWriteBuffer.GetChannel(ch)[i] += mSample.Data()->GetChannel(0)[mRecordPos];
+                  mWriteBuffer.GetChannel(ch)[i] += recordData[mRecordPos];
             }
             ++mRecordPos;
          }
@@ -242,12 +244,15 @@ void Sampler::DrawModuleUnclipped()
 void Sampler::StopRecording()
 {
    mRecording = false;
+   mRecordData = nullptr;
    mSample.SetStopPoint(mRecordPos);
 }
 
 float Sampler::DetectSamplePitch()
 {
-   float pitch = mPitchDetector.DetectPitch(mSample.Data()->GetChannel(0), mSample.LengthInSamples());
+   auto analysis = SampleAnalysis::Analyze(&mSample); //instant if this audio has been analysed before
+   analysis->Wait();
+   float pitch = analysis->GetResult()->mPitch;
    ofLog() << "Detected pitch: " << pitch;
    return pitch;
 }
@@ -269,6 +274,7 @@ void Sampler::FilesDropped(std::vector<std::string> files, int x, int y)
    mSample.LockDataMutex(true);
    mSample.Read(files[0].c_str());
    mSample.LockDataMutex(false);
+   SampleAnalysis::Analyze(&mSample); //in the background, so that detecting the pitch later is instant
    UpdateForNewSample();
 }
 
@@ -314,10 +320,13 @@ void Sampler::CheckboxUpdated(Checkbox* checkbox, double time)
    {
       if (mRecording)
       {
+         //EditData() can wait on a decode or copy shared data, so get the buffer to record into here rather than on the audio thread
+         ScopedMutex mutex(TheSynth->GetAudioMutex(), "Sampler::CheckboxUpdated()");
          mRecordPos = 0;
          mSample.LockDataMutex(true);
          mSample.Create(3.0f * gSampleRate);
          mSample.SetName("recorded");
+         mRecordData = mSample.EditData()->GetChannel(0);
          mSample.LockDataMutex(false);
          UpdateForNewSample();
       }
@@ -371,7 +380,7 @@ void Sampler::LoadState(FileStreamIn& in, int rev)
          length = 2 * gSampleRate;
 
       mSample.Create(length);
-      in.Read(mSample.Data()->GetChannel(0), length);
+      in.Read(mSample.EditData()->GetChannel(0), length);
 
       int sampleLength;
       if (rev >= 1)
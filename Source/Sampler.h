@@ -34,7 +34,6 @@
 #include "DropdownList.h"
 #include "ADSRDisplay.h"
 #include "Checkbox.h"
-#include "PitchDetector.h"
 #include "TextEntry.h"
 #include "ClickButton.h"
 #include "Sample.h"
@@ -113,6 +112,7 @@ private:
    Sample mSample{};
    int mRecordPos{ 0 };
    bool mRecording{ false };
+   float* mRecordData{ nullptr }; //mSample's writable data while recording, grabbed on the main thread when recording starts
    Checkbox* mRecordCheckbox{ nullptr };
    ClickButton* mDetectPitchButton{ nullptr };
    bool mPassthrough{ false };
@@ -122,8 +122,6 @@ private:
 
    ChannelBuffer mWriteBuffer;
 
-   PitchDetector mPitchDetector;
-
    struct DebugLine
    {
       std::string text;
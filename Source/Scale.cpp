@@ -44,10 +44,16 @@ Scale::Scale()
    assert(TheScale == nullptr);
    TheScale = this;
    SetName("scale");
+
+   RebuildPitchTable();
 }
 
 Scale::~Scale()
 {
+   delete mPitchTable.load();
+   for (auto& retired : mRetiredPitchTables)
+      delete retired.first;
+
    if (mOddsoundMTSClient)
    {
       MTS_DeregisterClient(mOddsoundMTSClient);
@@ -172,6 +178,110 @@ void Scale::Init()
 }
 
 float Scale::PitchToFreq(float pitch)
+{
+   if (IsPitchTableStale())
+      return ComputeFreq(pitch);
+
+   const PitchTable* table = mPitchTable.load(std::memory_order_acquire);
+   float pos = (pitch - kPitchTableMinPitch) * kPitchTableStepsPerPitch;
+   if (pos >= 0 && pos < kPitchTableSize)
+   {
+      int index = (int)pos;
+      float a = pos - index;
+      return table->mFreqs[index] + a * (table->mFreqs[index + 1] - table->mFreqs[index]);
+   }
+   return ComputeFreq(pitch); //way off the table (or nan)
+}
+
+void Scale::PitchToFreq(const float* pitches, float* freqs, int numSamples)
+{
+   if (IsPitchTableStale())
+   {
+      for (int i = 0; i < numSamples; ++i)
+         freqs[i] = ComputeFreq(pitches[i]);
+      return;
+   }
+
+   const PitchTable* table = mPitchTable.load(std::memory_order_acquire); //the same table for the whole buffer
+   const float* tableFreqs = table->mFreqs.data();
+   for (int i = 0; i < numSamples; ++i)
+   {
+      float pos = (pitches[i] - kPitchTableMinPitch) * kPitchTableStepsPerPitch;
+      if (pos >= 0 && pos < kPitchTableSize)
+      {
+         int index = (int)pos;
+         float a = pos - index;
+         freqs[i] = tableFreqs[index] + a * (tableFreqs[index + 1] - tableFreqs[index]);
+      }
+      else
+      {
+         freqs[i] = ComputeFreq(pitches[i]);
+      }
+   }
+}
+
+void Scale::RebuildPitchTable()
+{
+   if (IsAudioThread())
+   {
+      //building a table is thousands of ComputeFreq() calls and an allocation, so leave that for Poll()
+      ++mAudioThreadTuningChanges;
+      return;
+   }
+
+   int tuningChanges = mAudioThreadTuningChanges; //anything after this might not make it into the table, so it stays stale for the next Poll()
+   PitchTable* table = new PitchTable();
+   for (int i = 0; i <= kPitchTableSize; ++i)
+      table->mFreqs[i] = ComputeFreq(kPitchTableMinPitch + float(i) / kPitchTableStepsPerPitch);
+
+   const PitchTable* oldTable = mPitchTable.exchange(table, std::memory_order_acq_rel);
+   mPitchTableTuningChanges = tuningChanges;
+   if (oldTable != nullptr)
+   {
+      std::lock_guard<std::mutex> lock(mRetiredPitchTablesMutex);
+      mRetiredPitchTables.push_back(std::make_pair(oldTable, gTime));
+   }
+}
+
+void Scale::FreeRetiredPitchTables()
+{
+   std::lock_guard<std::mutex> lock(mRetiredPitchTablesMutex);
+   for (auto iter = mRetiredPitchTables.begin(); iter != mRetiredPitchTables.end();)
+   {
+      if (gTime - iter->second > 1000) //plenty of buffers for any PitchToFreq() call that grabbed it to have finished
+      {
+         delete iter->first;
+         iter = mRetiredPitchTables.erase(iter);
+      }
+      else
+      {
+         ++iter;
+      }
+   }
+}
+
+//the oddsound master can retune at any time without telling us, so keep an eye on it
+void Scale::PollOddsoundRetuning()
+{
+   if (mIntonation != kIntonation_Oddsound)
+      return;
+
+   bool changed = false;
+   for (int i = 0; i < (int)mOddsoundFreqs.size(); ++i)
+   {
+      float freq = ComputeFreq(i);
+      if (freq != mOddsoundFreqs[i])
+      {
+         mOddsoundFreqs[i] = freq;
+         changed = true;
+      }
+   }
+
+   if (changed)
+      RebuildPitchTable();
+}
+
+float Scale::ComputeFreq(float pitch)
 {
    if (mIntonation == kIntonation_SclFile)
    {
@@ -194,9 +304,17 @@ float Scale::PitchToFreq(float pitch)
       if (mOddsoundMTSClient && MTS_HasMaster(mOddsoundMTSClient))
       {
          if (pitch < 0 || pitch > 127)
+         {
             return Pow2((pitch - mReferencePitch) / mPitchesPerOctave) * mReferenceFreq; // Improve this obviously
+         }
          else
-            return MTS_NoteToFrequency(mOddsoundMTSClient, (int)pitch, 0);
+         {
+            //interpolate between notes in log space, so pitch bend still works
+            int intPitch = (int)pitch;
+            float freq1 = MTS_NoteToFrequency(mOddsoundMTSClient, intPitch, 0);
+            float freq2 = MTS_NoteToFrequency(mOddsoundMTSClient, MIN(intPitch + 1, 127), 0);
+            return freq1 * powf(freq2 / freq1, pitch - intPitch);
+         }
       }
       else
       {
@@ -316,6 +434,9 @@ void Scale::SetRoot(int root, bool force)
 
    mScale.SetRoot(root);
 
+   if (mIntonation == kIntonation_Pythagorean || mIntonation == kIntonation_Just || mIntonation == kIntonation_Meantone || mIntonation == kIntonation_Rational)
+      RebuildPitchTable(); //these are tuned relative to the root
+
    NotifyListeners();
 }
 
@@ -558,6 +679,11 @@ void Scale::Poll()
 {
    ComputeSliders(0);
 
+   PollOddsoundRetuning();
+   if (IsPitchTableStale())
+      RebuildPitchTable();
+   FreeRetiredPitchTables();
+
    if (mWantSetRandomRootAndScale)
    {
       SetRandomRootAndScale();
@@ -802,6 +928,8 @@ void Scale::UpdateTuningTable()
             mTuningTable[i] *= ratio;
       }
    }
+
+   RebuildPitchTable();
 }
 
 float Scale::GetTuningTableRatio(int semitonesFromCenter)
@@ -894,6 +1022,10 @@ void Scale::LoadState(FileStreamIn& in, int rev)
       ofLog() << "Restoring SCL/KBM from streaming";
       UpdateTuningTable();
    }
+   else
+   {
+      RebuildPitchTable();
+   }
 }
 
 void ScalePitches::SetRoot(int root)
@@ -31,6 +31,7 @@
 #include "Chord.h"
 #include "ChordDatabase.h"
 #include <atomic>
+#include <mutex>
 #include "AbletonDeviceShared.h"
 
 class IScaleListener
@@ -122,6 +123,7 @@ public:
    int GetPitchesPerOctave() const { return MAX(1, mPitchesPerOctave); }
 
    float PitchToFreq(float pitch);
+   void PitchToFreq(const float* pitches, float* freqs, int numSamples); //a buffer at a time, freqs can be the same buffer as pitches
    float FreqToPitch(float freq);
 
    const ChordDatabase& GetChordDatabase() const { return mChordDatabase; }
@@ -166,6 +168,10 @@ private:
    float RationalizeNumber(float input);
    void UpdateTuningTable();
    float GetTuningTableRatio(int semitonesFromCenter);
+   float ComputeFreq(float pitch);
+   void RebuildPitchTable();
+   void PollOddsoundRetuning();
+   void FreeRetiredPitchTables();
    void SetRandomRootAndScale();
    int GridToPitch(int x, int y) const;
 
@@ -206,6 +212,25 @@ private:
 
    std::array<float, 256> mTuningTable{};
 
+   //ComputeFreq() sampled every 1/16th of a pitch, so PitchToFreq() is a lerp between two neighbors in whatever intonation we're in.
+   //rebuilt whenever the tuning changes, and swapped in whole so the audio thread never sees a half-written table.
+   static constexpr int kPitchTableMinPitch = -64;
+   static constexpr int kPitchTableRange = 256;
+   static constexpr int kPitchTableStepsPerPitch = 16;
+   static constexpr int kPitchTableSize = kPitchTableRange * kPitchTableStepsPerPitch;
+   struct PitchTable
+   {
+      std::array<float, kPitchTableSize + 1> mFreqs;
+   };
+   std::atomic<const PitchTable*> mPitchTable{ nullptr };
+   //when the tuning changes on the audio thread, Poll() rebuilds the table, and ComputeFreq() is used until it has
+   std::atomic<int> mAudioThreadTuningChanges{ 0 };
+   std::atomic<int> mPitchTableTuningChanges{ 0 }; //how many of those the current table includes
+   bool IsPitchTableStale() const { return mPitchTableTuningChanges != mAudioThreadTuningChanges; }
+   std::mutex mRetiredPitchTablesMutex;
+   std::vector<std::pair<const PitchTable*, double>> mRetiredPitchTables; //replaced tables and when, deleted once nobody can still be reading them
+   std::array<float, 128> mOddsoundFreqs{};
+
    ChordDatabase mChordDatabase;
 
    MTSClient* mOddsoundMTSClient{ nullptr };
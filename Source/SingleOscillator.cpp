@@ -85,6 +85,7 @@ void SingleOscillator::CreateUIControls()
    INTSLIDER(mUnisonSlider, "unison", &mVoiceParams.mUnison, 1, SingleOscillatorVoice::kMaxUnison);
    FLOATSLIDER(mUnisonWidthSlider, "width", &mVoiceParams.mUnisonWidth, 0, 1);
    CHECKBOX(mLiteCPUModeCheckbox, "lite cpu", &mVoiceParams.mLiteCPUMode);
+   DROPDOWN(mOversamplingDropdown, "oversample", &mOversampling, 40);
    ENDUIBLOCK(width, height);
    mWidth = MAX(width, mWidth);
    mHeight = MAX(height, mHeight);
@@ -121,6 +122,8 @@ void SingleOscillator::CreateUIControls()
    mWidth = MAX(width, mWidth);
    mHeight = MAX(height, mHeight);
 
+   Oversampler::FillDropdown(mOversamplingDropdown);
+
    mOscSelector->AddLabel("sin", kOsc_Sin);
    mOscSelector->AddLabel("squ", kOsc_Square);
    mOscSelector->AddLabel("tri", kOsc_Tri);
@@ -184,6 +187,15 @@ void SingleOscillator::Process(double time)
 
    mNoteInputBuffer.Process(time);
 
+   if (mPolyMgr.IsIdle())
+   {
+      //leave our target untouched, so that it stays flagged as silent and downstream effects can sleep. the visualization still
+      //needs to show the silence though, or our cables keep drawing the last buffer we played.
+      for (int ch = 0; ch < mWriteBuffer.NumActiveChannels(); ++ch)
+         GetVizBuffer()->WriteChunk(gZeroBuffer, gBufferSize, ch);
+      return;
+   }
+
    ComputeSliders(0);
 
    int bufferSize = target->GetBuffer()->BufferSize();
@@ -280,6 +292,7 @@ void SingleOscillator::DrawModule()
    mMultSelector->Draw();
    mSoftenSlider->Draw();
    mLiteCPUModeCheckbox->Draw();
+   mOversamplingDropdown->Draw();
 
    {
       ofPushStyle();
@@ -433,6 +446,8 @@ void SingleOscillator::DropdownUpdated(DropdownList* list, int oldVal, double ti
    }
    if (list == mOscSelector)
       mDrawOsc.SetType(mVoiceParams.mOscType);
+   if (list == mOversamplingDropdown)
+      mPolyMgr.SetOversampling(mOversampling);
 }
 
 void SingleOscillator::RadioButtonUpdated(RadioButton* list, int oldVal, double time)
@@ -100,6 +100,7 @@ private:
    FloatSlider* mPulseWidthSlider{ nullptr };
    FloatSlider* mSoftenSlider{ nullptr };
    int mMult{ 1 };
+   int mOversampling{ 1 };
    DropdownList* mMultSelector{ nullptr };
    ADSRDisplay* mADSRDisplay{ nullptr };
    DropdownList* mSyncModeSelector{ nullptr };
@@ -112,6 +113,7 @@ private:
    FloatSlider* mVelToVolumeSlider{ nullptr };
    FloatSlider* mVelToEnvelopeSlider{ nullptr };
    Checkbox* mLiteCPUModeCheckbox{ nullptr };
+   DropdownList* mOversamplingDropdown{ nullptr };
 
    FloatSlider* mFilterCutoffMaxSlider{ nullptr };
    FloatSlider* mFilterCutoffMinSlider{ nullptr };
@@ -62,14 +62,26 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
    float syncPhaseInc;
 
    if (mVoiceParams->mLiteCPUMode)
-      DoParameterUpdate(0, pitch, freq, vol, syncPhaseInc);
+      DoParameterUpdate(0, oversampling, pitch, freq, vol, syncPhaseInc);
 
-   for (int pos = 0; pos < out->BufferSize(); ++pos)
+   if (mUseFilter && oversampling != mFilterOversampling)
+   {
+      mFilterOversampling = oversampling;
+      mFilterLeft.SetSampleRate(gSampleRate * oversampling);
+      mFilterRight.SetSampleRate(gSampleRate * oversampling);
+      mFilterLeft.UpdateFilterCoeff();
+   }
+
+   double sampleIncrementMs = gInvSampleRateMs / oversampling;
+   ::ADSR::Renderer adsr(mAdsr, time, sampleIncrementMs);
+   ::ADSR::Renderer filterAdsr(mFilterAdsr, time, sampleIncrementMs);
+
+   for (int pos = 0; pos < out->BufferSize(); ++pos) //already oversampled, PolyphonyMgr filters it back down
    {
       if (!mVoiceParams->mLiteCPUMode)
-         DoParameterUpdate(pos, pitch, freq, vol, syncPhaseInc);
+         DoParameterUpdate(pos / oversampling, oversampling, pitch, freq, vol, syncPhaseInc);
 
-      float adsrVal = mAdsr.Value(time);
+      float adsrVal = adsr.Next();
 
       float summedLeft = 0;
       float summedRight = 0;
@@ -84,7 +96,7 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
             mOscData[u].mPhase += mOscData[u].mCurrentPhaseInc;
             if (std::isinf(mOscData[u].mPhase))
             {
-               ofLog() << "Infinite phase. phaseInc:" + ofToString(mOscData[u].mCurrentPhaseInc) + " detune:" + ofToString(mVoiceParams->mDetune) + " freq:" + ofToString(freq) + " pitch:" + ofToString(pitch) + " getpitch:" + ofToString(GetPitch(pos));
+               ofLog() << "Infinite phase. phaseInc:" + ofToString(mOscData[u].mCurrentPhaseInc) + " detune:" + ofToString(mVoiceParams->mDetune) + " freq:" + ofToString(freq) + " pitch:" + ofToString(pitch) + " getpitch:" + ofToString(GetPitch(pos / oversampling));
                // Reset to 0 because letting this propagate causes NaN's
                mOscData[u].mPhase = 0;
                mOscData[u].mCurrentPhaseInc = 0;
@@ -144,7 +156,7 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
       if (mUseFilter)
       {
          //PROFILER(SingleOscillatorVoice_filter);
-         float f = ofLerp(mVoiceParams->mFilterCutoffMin, mVoiceParams->mFilterCutoffMax, mFilterAdsr.Value(time)) * (1 - GetModWheel(pos) * .9f);
+         float f = ofLerp(mVoiceParams->mFilterCutoffMin, mVoiceParams->mFilterCutoffMax, filterAdsr.Next()) * (1 - GetModWheel(pos / oversampling) * .9f);
          float q = mVoiceParams->mFilterQ;
          if (f != mFilterLeft.mF || q != mFilterLeft.mQ)
             mFilterLeft.SetFilterParams(f, q);
@@ -168,13 +180,13 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
             out->GetChannel(1)[pos] += summedRight;
          }
       }
-      time += gInvSampleRateMs;
    }
 
    return true;
 }
 
 void SingleOscillatorVoice::DoParameterUpdate(int samplesIn,
+                                              int oversampling,
                                               float& pitch,
                                               float& freq,
                                               float& vol,
@@ -184,19 +196,19 @@ void SingleOscillatorVoice::DoParameterUpdate(int samplesIn,
       mOwner->ComputeSliders(samplesIn);
 
    pitch = GetPitch(samplesIn);
-   freq = TheScale->PitchToFreq(pitch) * mVoiceParams->mMult;
+   freq = GetFreq(samplesIn) * mVoiceParams->mMult;
    vol = mVoiceParams->mVol * .4f / mVoiceParams->mUnison;
    if (mVoiceParams->mSyncMode == Oscillator::SyncMode::Frequency)
-      syncPhaseInc = GetPhaseInc(mVoiceParams->mSyncFreq);
+      syncPhaseInc = GetPhaseInc(mVoiceParams->mSyncFreq) / oversampling;
    else if (mVoiceParams->mSyncMode == Oscillator::SyncMode::Ratio)
-      syncPhaseInc = GetPhaseInc(freq * mVoiceParams->mSyncRatio);
+      syncPhaseInc = GetPhaseInc(freq * mVoiceParams->mSyncRatio) / oversampling;
    else
       syncPhaseInc = 0;
 
    for (int u = 0; u < mVoiceParams->mUnison && u < kMaxUnison; ++u)
    {
       float detune = exp2(mVoiceParams->mDetune * mOscData[u].mDetuneFactor * (1 - GetPressure(samplesIn)));
-      mOscData[u].mCurrentPhaseInc = GetPhaseInc(freq * detune);
+      mOscData[u].mCurrentPhaseInc = GetPhaseInc(freq * detune) / oversampling;
    }
 }
 
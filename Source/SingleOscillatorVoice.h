@@ -85,6 +85,7 @@ public:
 
 private:
    void DoParameterUpdate(int samplesIn,
+                          int oversampling,
                           float& pitch,
                           float& freq,
                           float& vol,
@@ -106,6 +107,7 @@ private:
    BiquadFilter mFilterLeft;
    BiquadFilter mFilterRight;
    bool mUseFilter{ false };
+   int mFilterOversampling{ 1 }; //what the filters' sample rate is currently set up for
 
    IDrawableModule* mOwner;
 };
@@ -49,8 +49,6 @@ FloatSlider::FloatSlider(IFloatSliderListener* owner, const char* label, int x,
    SetPosition(x, y);
    (dynamic_cast<IDrawableModule*>(owner))->AddUIControl(this);
    SetParent(dynamic_cast<IClickable*>(owner));
-   mLastComputeCacheTime = new double[gBufferSize];
-   mLastComputeCacheValue = new float[gBufferSize];
 }
 
 FloatSlider::FloatSlider(IFloatSliderListener* owner, const char* label, IUIControl* anchor, AnchorDirection anchorDir, int w, int h, float* var, float min, float max, int digits /* = -1 */)
@@ -63,6 +61,7 @@ FloatSlider::~FloatSlider()
 {
    if (mIsSmoothing)
       TheTransport->RemoveAudioPoller(this);
+   TheSynth->GetModulationGraph()->OnSliderDeleted(this);
 }
 
 void FloatSlider::Init()
@@ -99,6 +98,7 @@ void FloatSlider::SetModulator(IModulator* modulator)
       mLFOControl = nullptr;
       if (oldModulator != nullptr)
          oldModulator->OnRemovedFrom(this);
+      TheSynth->GetModulationGraph()->OnModulatorChanged(this);
    }
 }
 
@@ -657,7 +657,7 @@ void FloatSlider::DoCompute(int samplesIn /*= 0*/)
    if (mLastComputeTime == gTime && mLastComputeSamplesIn == samplesIn)
       return; //we've just calculated this, no need to do it again! earlying out avoids wasted work and circular modulation loops
 
-   if (mLFOControl && mLFOControl->Active() && mLFOControl->InLowResMode() && samplesIn != 0)
+   if (HasLowResModulation() && samplesIn != 0)
       return; //only do the math on Compute(0) for low res mode
 
    mLastComputeTime = gTime;
@@ -665,33 +665,56 @@ void FloatSlider::DoCompute(int samplesIn /*= 0*/)
 
    float oldVal = *mVar;
 
-   const bool kUseCache = true;
-   if (kUseCache && IsAudioThread() && samplesIn >= 0 && samplesIn < gBufferSize && mLastComputeCacheTime[samplesIn] == gTime)
-   {
-      *mVar = mLastComputeCacheValue[samplesIn];
-   }
+   if (mModulationNode != -1 && IsAudioThread() && samplesIn >= 0 && samplesIn < gBufferSize)
+      *mVar = TheSynth->GetModulationGraph()->GetValue(mModulationNode, samplesIn);
    else
+      *mVar = EvaluateModulation(samplesIn);
+
+   if (oldVal != *mVar)
    {
-      if (mModulator && mModulator->Active())
+      if (mUpdateGranularity == kUpdatePerBuffer && IsAudioThread())
       {
-         if (mIsSmoothing)
-            mSmoothTarget = mModulator->Value(samplesIn);
-         else
-            *mVar = mModulator->Value(samplesIn);
+         if (!mUpdatePending)
+         {
+            mUpdatePending = true;
+            mPendingUpdateOldValue = oldVal;
+            TheSynth->GetModulationGraph()->QueueUpdate(this);
+         }
       }
-
-      if (mIsSmoothing)
-         *mVar = mRamp.Value(gTime + samplesIn * gInvSampleRateMs);
-
-      if (IsAudioThread() && samplesIn >= 0 && samplesIn < gBufferSize && mLastComputeCacheTime[samplesIn] != gTime)
+      else
       {
-         mLastComputeCacheValue[samplesIn] = *mVar;
-         mLastComputeCacheTime[samplesIn] = gTime;
+         mOwner->FloatSliderUpdated(this, oldVal, gTime + samplesIn * gInvSampleRateMs);
       }
    }
+}
 
-   if (oldVal != *mVar)
-      mOwner->FloatSliderUpdated(this, oldVal, gTime + samplesIn * gInvSampleRateMs);
+void FloatSlider::SendPendingUpdate(double time)
+{
+   mUpdatePending = false;
+   if (*mVar != mPendingUpdateOldValue) //it may have come back to where it started
+      mOwner->FloatSliderUpdated(this, mPendingUpdateOldValue, time);
+}
+
+float FloatSlider::EvaluateModulation(int samplesIn)
+{
+   float value = *mVar;
+   if (mModulator && mModulator->Active())
+   {
+      if (mIsSmoothing)
+         mSmoothTarget = mModulator->Value(samplesIn);
+      else
+         value = mModulator->Value(samplesIn);
+   }
+
+   if (mIsSmoothing)
+      value = mRamp.Value(gTime + samplesIn * gInvSampleRateMs);
+
+   return value;
+}
+
+bool FloatSlider::HasLowResModulation() const
+{
+   return mLFOControl && mLFOControl->Active() && mLFOControl->InLowResMode();
 }
 
 float* FloatSlider::GetModifyValue()
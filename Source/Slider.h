@@ -61,9 +61,10 @@ public:
    void Compute(int samplesIn = 0)
    {
       mComputeHasBeenCalledOnce = true; //mark this slider as one whose owner calls compute on it
-      if (mIsSmoothing || mModulator != nullptr)
+      if (IsChangingOverTime())
          DoCompute(samplesIn);
    }
+   bool IsChangingOverTime() const { return mIsSmoothing || mModulator != nullptr; } //if not, Compute() won't change the value within a buffer
    void DisplayLFOControl();
    void DisableLFO();
    FloatSliderLFOControl* GetLFO() { return mLFOControl; }
@@ -85,6 +86,16 @@ public:
    void SetBezierControl(float control) { mBezierControl = control; }
    void SetModulator(IModulator* modulator);
    IModulator* GetModulator() override { return mModulator; }
+   float EvaluateModulation(int samplesIn); //for ModulationGraph, what DoCompute(samplesIn) would set the value to
+   void SetModulationNode(int node) { mModulationNode = node; }
+   bool HasLowResModulation() const;
+   enum UpdateGranularity
+   {
+      kUpdatePerSample, //owner hears about every sample the value changes on
+      kUpdatePerBuffer //owner hears about it once, after the buffer, with the value the buffer started at as oldVal
+   };
+   void SetUpdateGranularity(UpdateGranularity granularity) { mUpdateGranularity = granularity; }
+   void SendPendingUpdate(double time); //for ModulationGraph, delivers a kUpdatePerBuffer change
    float& GetModulatorMin() { return mModulatorMin; }
    float& GetModulatorMax() { return mModulatorMax; }
    bool ModulatorUsesLiteralValue() const override { return true; }
@@ -188,8 +199,10 @@ private:
    bool mComputeHasBeenCalledOnce{ false };
    double mLastComputeTime{ 0 };
    int mLastComputeSamplesIn{ 0 };
-   double* mLastComputeCacheTime;
-   float* mLastComputeCacheValue;
+   int mModulationNode{ -1 }; //where ModulationGraph keeps our per-buffer values, or -1 if it doesn't
+   UpdateGranularity mUpdateGranularity{ kUpdatePerSample };
+   bool mUpdatePending{ false };
+   float mPendingUpdateOldValue{ 0 };
    std::vector<float> mDetents;
    double mLastHitDetentTimeMs{ 0 };
    int mLastAdjustdDirection{ 0 };
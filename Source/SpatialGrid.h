@@ -0,0 +1,258 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2026 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SpatialGrid.h
+    Created: 19 Oct 2026
+    Author:  Ryan Challinor
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SynthGlobals.h"
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//uniform grid over item bounds, used as a broad phase for hit-testing so we don't have to ask every item on the canvas
+template <class T>
+class SpatialGrid
+{
+public:
+   explicit SpatialGrid(float cellSize = 256)
+   : mCellSize(cellSize)
+   {
+   }
+
+   //inserts the item, or moves it if it's already in the grid. cheap if the bounds didn't change.
+   void Update(T* item, const ofRectangle& bounds)
+   {
+      auto iter = mItems.find(item);
+      if (iter != mItems.end())
+      {
+         Entry& entry = iter->second;
+         if (entry.bounds.x == bounds.x && entry.bounds.y == bounds.y && entry.bounds.width == bounds.width && entry.bounds.height == bounds.height)
+            return;
+
+         Entry newEntry = MakeEntry(bounds);
+         if (newEntry.minX == entry.minX && newEntry.minY == entry.minY && newEntry.maxX == entry.maxX && newEntry.maxY == entry.maxY && newEntry.oversized == entry.oversized)
+         {
+            entry.bounds = bounds; //same cells, nothing to relink
+            return;
+         }
+
+         Unlink(item, entry);
+         entry = newEntry;
+         Link(item, entry);
+      }
+      else
+      {
+         Entry entry = MakeEntry(bounds);
+         Link(item, entry);
+         mItems[item] = entry;
+      }
+   }
+
+   void Remove(T* item)
+   {
+      auto iter = mItems.find(item);
+      if (iter == mItems.end())
+         return;
+      Unlink(item, iter->second);
+      mItems.erase(iter);
+   }
+
+   void Clear()
+   {
+      mCells.clear();
+      mItems.clear();
+      mOversized.clear();
+   }
+
+   bool Contains(T* item) const { return mItems.find(item) != mItems.end(); }
+   size_t Size() const { return mItems.size(); }
+
+   //appends every item whose bounds contain the point, in no particular order
+   void QueryPoint(float x, float y, std::vector<T*>& output) const
+   {
+      auto cell = mCells.find(Key(CellCoord(x), CellCoord(y)));
+      if (cell != mCells.end())
+      {
+         for (auto* item : cell->second)
+         {
+            if (ContainsInclusive(mItems.at(item).bounds, x, y))
+               output.push_back(item);
+         }
+      }
+      for (auto* item : mOversized)
+      {
+         if (ContainsInclusive(mItems.at(item).bounds, x, y))
+            output.push_back(item);
+      }
+   }
+
+   //appends every item whose bounds intersect the rect, each item at most once, in no particular order
+   void QueryRect(const ofRectangle& rect, std::vector<T*>& output) const
+   {
+      int minX = CellCoord(rect.getMinX());
+      int minY = CellCoord(rect.getMinY());
+      int maxX = CellCoord(rect.getMaxX());
+      int maxY = CellCoord(rect.getMaxY());
+
+      if ((int64_t)(maxX - minX + 1) * (maxY - minY + 1) > (int64_t)mItems.size())
+      {
+         //cheaper to just check everything than to walk that many cells
+         for (const auto& item : mItems)
+         {
+            if (Intersects(item.second.bounds, rect))
+               output.push_back(item.first);
+         }
+         return;
+      }
+
+      for (int cy = minY; cy <= maxY; ++cy)
+      {
+         for (int cx = minX; cx <= maxX; ++cx)
+         {
+            auto cell = mCells.find(Key(cx, cy));
+            if (cell == mCells.end())
+               continue;
+            for (auto* item : cell->second)
+            {
+               const Entry& entry = mItems.at(item);
+               //only report an item from the first cell of the query that it overlaps, to avoid duplicates
+               if (cx != std::max(minX, entry.minX) || cy != std::max(minY, entry.minY))
+                  continue;
+               if (Intersects(entry.bounds, rect))
+                  output.push_back(item);
+            }
+         }
+      }
+      for (auto* item : mOversized)
+      {
+         if (Intersects(mItems.at(item).bounds, rect))
+            output.push_back(item);
+      }
+   }
+
+   //union of all item bounds
+   bool GetTotalBounds(ofRectangle& bounds) const
+   {
+      bool first = true;
+      for (const auto& item : mItems)
+      {
+         if (first)
+            bounds = item.second.bounds;
+         else
+            bounds = ofRectangle::include(bounds, item.second.bounds);
+         first = false;
+      }
+      return !first;
+   }
+
+private:
+   struct Entry
+   {
+      ofRectangle bounds;
+      int minX{ 0 };
+      int minY{ 0 };
+      int maxX{ 0 };
+      int maxY{ 0 };
+      bool oversized{ false };
+   };
+
+   static constexpr int64_t kMaxCellsPerItem = 1024;
+
+   int CellCoord(float value) const
+   {
+      return (int)std::floor(value / mCellSize);
+   }
+
+   static uint64_t Key(int cx, int cy)
+   {
+      return ((uint64_t)(uint32_t)cx << 32) | (uint64_t)(uint32_t)cy;
+   }
+
+   static bool ContainsInclusive(const ofRectangle& rect, float x, float y)
+   {
+      return x >= rect.getMinX() && x <= rect.getMaxX() && y >= rect.getMinY() && y <= rect.getMaxY();
+   }
+
+   static bool Intersects(const ofRectangle& a, const ofRectangle& b)
+   {
+      return a.getMinX() <= b.getMaxX() && a.getMaxX() >= b.getMinX() &&
+             a.getMinY() <= b.getMaxY() && a.getMaxY() >= b.getMinY();
+   }
+
+   Entry MakeEntry(const ofRectangle& bounds) const
+   {
+      Entry entry;
+      entry.bounds = bounds;
+      entry.minX = CellCoord(bounds.getMinX());
+      entry.minY = CellCoord(bounds.getMinY());
+      entry.maxX = CellCoord(bounds.getMaxX());
+      entry.maxY = CellCoord(bounds.getMaxY());
+      entry.oversized = (int64_t)(entry.maxX - entry.minX + 1) * (entry.maxY - entry.minY + 1) > kMaxCellsPerItem;
+      return entry;
+   }
+
+   void Link(T* item, const Entry& entry)
+   {
+      if (entry.oversized)
+      {
+         mOversized.push_back(item);
+         return;
+      }
+      for (int cy = entry.minY; cy <= entry.maxY; ++cy)
+      {
+         for (int cx = entry.minX; cx <= entry.maxX; ++cx)
+            mCells[Key(cx, cy)].push_back(item);
+      }
+   }
+
+   void Unlink(T* item, const Entry& entry)
+   {
+      if (entry.oversized)
+      {
+         RemoveFromVector(item, mOversized);
+         return;
+      }
+      for (int cy = entry.minY; cy <= entry.maxY; ++cy)
+      {
+         for (int cx = entry.minX; cx <= entry.maxX; ++cx)
+         {
+            auto cell = mCells.find(Key(cx, cy));
+            if (cell == mCells.end())
+               continue;
+            RemoveFromVector(item, cell->second);
+            if (cell->second.empty())
+               mCells.erase(cell);
+         }
+      }
+   }
+
+   float mCellSize{ 256 };
+   std::unordered_map<uint64_t, std::vector<T*>> mCells;
+   std::unordered_map<T*, Entry> mItems;
+   std::vector<T*> mOversized;
+};
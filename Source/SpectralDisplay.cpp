@@ -94,15 +94,11 @@ void SpectralDisplay::Process(double time)
    IAudioReceiver* target = GetTarget();
    if (target)
    {
-      ChannelBuffer* out = target->GetBuffer();
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-      {
-         Add(out->GetChannel(ch), GetBuffer()->GetChannel(ch), out->BufferSize());
          GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
-      }
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void SpectralDisplay::DrawModule()
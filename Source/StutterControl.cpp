@@ -88,15 +88,11 @@ void StutterControl::Process(double time)
    {
       mStutterProcessor.ProcessAudio(time, GetBuffer());
 
-      ChannelBuffer* out = target->GetBuffer();
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-      {
-         Add(out->GetChannel(ch), GetBuffer()->GetChannel(ch), out->BufferSize());
          GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
-      }
    }
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
 }
 
 void StutterControl::DrawModule()
@@ -40,6 +40,9 @@
 #include "UserPrefs.h"
 #include "SimplexFont.h"
 
+#include <memory>
+#include <mutex>
+
 #include "juce_audio_formats/juce_audio_formats.h"
 #include "juce_gui_basics/juce_gui_basics.h"
 
@@ -335,6 +338,19 @@ void BufferCopy(float* dst, const float* src, int bufferSize)
 #endif
 }
 
+float GetPeak(const float* buffer, int bufferSize)
+{
+#ifdef USE_VECTOR_OPS
+   auto range = FloatVectorOperations::findMinAndMax(buffer, bufferSize);
+   return MAX(-range.getStart(), range.getEnd());
+#else
+   float peak = 0;
+   for (int i = 0; i < bufferSize; ++i)
+      peak = MAX(peak, fabsf(buffer[i]));
+   return peak;
+#endif
+}
+
 std::string NoteName(int pitch, bool flat, bool includeOctave)
 {
    int octave = pitch / 12;
@@ -889,32 +905,58 @@ void DrawFallbackText(const char* text, float posX, float posY)
    }
 }
 
+namespace
+{
+   //compiled expressions, keyed by the string they were compiled from, so typing the same thing again doesn't reparse it
+   struct CachedExpression
+   {
+      exprtk::symbol_table<float> mSymbolTable;
+      exprtk::expression<float> mExpression;
+      float mX{ 0 };
+      bool mValid{ false };
+   };
+   std::mutex sExpressionCacheMutex;
+   std::map<std::string, std::unique_ptr<CachedExpression>> sExpressionCache;
+   const size_t kMaxCachedExpressions = 256;
+}
+
 bool EvaluateExpression(std::string expressionStr, float currentValue, float& output)
 {
-   exprtk::symbol_table<float> symbolTable;
-   exprtk::expression<float> expression;
-   symbolTable.add_variable("x", currentValue);
-   symbolTable.add_constants();
-   expression.register_symbol_table(symbolTable);
-
-   juce::String input = expressionStr;
-   if (input.startsWith("+="))
-      input = input.replace("+=", "x+");
-   if (input.startsWith("*="))
-      input = input.replace("*=", "x*");
-   if (input.startsWith("/="))
-      input = input.replace("/=", "x/");
-   if (input.startsWith("-="))
-      input = input.replace("-=", "x-");
-
-   exprtk::parser<float> parser;
-   bool expressionValid = parser.compile(input.toStdString(), expression);
-   if (expressionValid)
+   std::lock_guard<std::mutex> lock(sExpressionCacheMutex);
+
+   auto iter = sExpressionCache.find(expressionStr);
+   if (iter == sExpressionCache.end())
    {
-      output = expression.value();
-      return true;
+      if (sExpressionCache.size() >= kMaxCachedExpressions)
+         sExpressionCache.clear();
+
+      auto cached = std::make_unique<CachedExpression>();
+      cached->mSymbolTable.add_variable("x", cached->mX);
+      cached->mSymbolTable.add_constants();
+      cached->mExpression.register_symbol_table(cached->mSymbolTable);
+
+      juce::String input = expressionStr;
+      if (input.startsWith("+="))
+         input = input.replace("+=", "x+");
+      if (input.startsWith("*="))
+         input = input.replace("*=", "x*");
+      if (input.startsWith("/="))
+         input = input.replace("/=", "x/");
+      if (input.startsWith("-="))
+         input = input.replace("-=", "x-");
+
+      exprtk::parser<float> parser;
+      cached->mValid = parser.compile(input.toStdString(), cached->mExpression);
+      iter = sExpressionCache.emplace(expressionStr, std::move(cached)).first;
    }
-   return false;
+
+   CachedExpression* cached = iter->second.get();
+   if (!cached->mValid)
+      return false;
+
+   cached->mX = currentValue;
+   output = cached->mExpression.value();
+   return true;
 }
 
 ofLog::~ofLog()
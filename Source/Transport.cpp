@@ -698,15 +698,6 @@ void Transport::UpdateListeners(double jumpMs)
    }
 }
 
-void Transport::OnDrumEvent(NoteInterval drumEvent)
-{
-   for (const auto& info : mListeners)
-   {
-      if (info.mInterval == drumEvent)
-         info.mListener->OnTimeEvent(0); //TODO(Ryan) calc sample offset
-   }
-}
-
 bool Transport::OnAbletonGridControl_InputThread(IAbletonGridDevice* abletonGrid, int controlIndex, float midiValue)
 {
    if (controlIndex == AbletonDevice::kClickyEncoderTurn)
@@ -138,7 +138,6 @@ public:
    void SetDownbeat() { mMeasureTime = mMeasureTime - (int)mMeasureTime - .001; }
    static int CountInStandardMeasure(NoteInterval interval);
    void Reset(bool timeSensitive = false);
-   void OnDrumEvent(NoteInterval drumEvent);
    void SetLoop(int measureStart, int measureEnd)
    {
       assert(measureStart < measureEnd);
@@ -34,6 +34,7 @@
 #include "ModulationChain.h"
 #include "PatchCableSource.h"
 #include "UserPrefs.h"
+#include "PluginSandbox.h"
 //#include "NSWindowOverlay.h"
 
 namespace
@@ -540,32 +541,46 @@ void VSTPlugin::LoadVST(juce::PluginDescription desc)
 {
    mPluginReady = false;
 
-   mVSTMutex.lock();
+   //creating an instance can take a long time (a sandboxed plugin waits on its child process), so build and prepare it
+   //without holding mVSTMutex, and only lock to swap it in, so the audio thread isn't stalled
    juce::String errorMessage;
-   mPlugin = TheSynth->GetAudioPluginFormatManager().createPluginInstance(desc, gSampleRate, gBufferSize, errorMessage);
-   if (mPlugin != nullptr)
+   std::unique_ptr<juce::AudioProcessor> plugin;
+   if (UserPrefs.sandbox_plugins.Get())
+      plugin = SandboxedPluginInstance::Create(desc, gSampleRate, gBufferSize, errorMessage);
+   else
+      plugin = TheSynth->GetAudioPluginFormatManager().createPluginInstance(desc, gSampleRate, gBufferSize, errorMessage);
+   if (plugin != nullptr)
    {
-      mPlugin->enableAllBuses();
-      mPlugin->addListener(this);
+      plugin->enableAllBuses();
+      plugin->addListener(this);
 
-      mNumInputChannels = mPlugin->getTotalNumInputChannels();
-      mNumOutputChannels = mPlugin->getTotalNumOutputChannels();
-      ofLog() << "vst channel - inputs: " << mNumInputChannels << " x outputs: " << mNumOutputChannels;
+      int numInputChannels = plugin->getTotalNumInputChannels();
+      int numOutputChannels = plugin->getTotalNumOutputChannels();
+      ofLog() << "vst channel - inputs: " << numInputChannels << " x outputs: " << numOutputChannels;
 
-      auto layouts = mPlugin->getBusesLayout();
-      mNumInBuses = layouts.inputBuses.size();
-      mNumOutBuses = layouts.outputBuses.size();
-      mPlugin->enableAllBuses();
+      auto layouts = plugin->getBusesLayout();
+      plugin->enableAllBuses();
       ofLog() << "vst layout  - inputs: " << layouts.inputBuses.size() << " x outputs: " << layouts.outputBuses.size();
 
-      mPlugin->prepareToPlay(gSampleRate, gBufferSize);
-      mPlugin->setPlayHead(&mPlayhead);
+      plugin->prepareToPlay(gSampleRate, gBufferSize);
+      plugin->setPlayHead(&mPlayhead);
+
+      mVSTMutex.lock();
+      mPlugin.swap(plugin);
+      mNumInputChannels = numInputChannels;
+      mNumOutputChannels = numOutputChannels;
+      mNumInBuses = layouts.inputBuses.size();
+      mNumOutBuses = layouts.outputBuses.size();
+      PrepareProcessBuffers();
 
       mPluginName = mPlugin->getName().toStdString();
       mPluginFormatName = ofToString(desc.pluginFormatName.toLowerCase());
       mPluginId = GetPluginName() + "_" + ofToString(desc.uniqueId);
 
       CreateParameterSliders();
+      mVSTMutex.unlock();
+
+      plugin.reset(); //tear down the previous instance outside the lock too
 
       RefreshPresetFiles();
 
@@ -573,12 +588,39 @@ void VSTPlugin::LoadVST(juce::PluginDescription desc)
    }
    else
    {
+      mVSTMutex.lock();
+      mPlugin.swap(plugin);
+      mVSTMutex.unlock();
+      plugin.reset();
+
       TheSynth->LogEvent("error loading VST: " + errorMessage.toStdString(), kLogEventType_Error);
 
       if (mModuleSaveData.HasProperty("pluginId") && mModuleSaveData.GetString("pluginId").length() > 0)
          mPluginName = mModuleSaveData.GetString("pluginId") + " (not loaded)";
    }
-   mVSTMutex.unlock();
+}
+
+/*
+ * Multi-out VSTs which can't disable those outputs will expect *something* in the
+ * buffer even though we don't read it.
+ *
+ * Before processing audio in the VST we copy the Bespoke inputs into a juce buffer, the buffer needs enough mono channels to cover inputs and outputs
+ * So 2 inputs and 4 outputs means we need 4 channels total (the first two for inputs will be overwritten with the outputs)
+ */
+int VSTPlugin::GetProcessBufferChannelCount() const
+{
+   int inputChannels = MAX(2, mNumInputChannels);
+   int outputChannels = MAX(2, mNumOutputChannels);
+   return MAX(MAX(inputChannels * mNumInBuses, outputChannels * mNumOutBuses), 2);
+}
+
+void VSTPlugin::PrepareProcessBuffers()
+{
+   mProcessBuffer.setSize(GetProcessBufferChannelCount(), gBufferSize);
+
+   const size_t kMidiBufferReserveBytes = 8192;
+   mMidiBuffer.ensureSize(kMidiBufferReserveBytes);
+   mFutureMidiBuffer.ensureSize(kMidiBufferReserveBytes);
 }
 
 void VSTPlugin::CreateParameterSliders()
@@ -636,6 +678,13 @@ void VSTPlugin::CreateParameterSliders()
 
 void VSTPlugin::Poll()
 {
+   int latencySamples = (mPluginReady && mPlugin != nullptr && mEnabled) ? mPlugin->getLatencySamples() : 0;
+   if (latencySamples != mLatencySamples)
+   {
+      mLatencySamples = latencySamples;
+      TheSynth->ArrangeAudioSourceDependencies();
+   }
+
    if (mRescanParameterNames)
    {
       mRescanParameterNames = false;
@@ -810,7 +859,6 @@ void VSTPlugin::Process(double time)
    }
 
    int inputChannels = MAX(2, mNumInputChannels);
-   int outputChannels = MAX(2, mNumOutputChannels);
    ChannelBuffer* AllChannelsBuffer = GetBuffer();
 
    AllChannelsBuffer->SetNumActiveChannels(inputChannels);
@@ -841,23 +889,35 @@ void VSTPlugin::Process(double time)
          RecreateUIOutputCables();
    }
 
-   /*
-    * Multi-out VSTs which can't disable those outputs will expect *something* in the
-    * buffer even though we don't read it.
-    * 
-    * Before processing audio in the VST we copy the Bespoke inputs into a juce buffer, the buffer needs enough mono channels to cover inputs and outputs
-    * So 2 inputs and 4 outputs means we need 4 channels total (the first two for inputs will be overwritten with the outputs)
-    */
-   int juceBufferChannelCount = MAX(MAX(inputChannels * mNumInBuses, outputChannels * mNumOutBuses), 2); // how much to allocate in the juce::AudioBuffer
+   int juceBufferChannelCount = GetProcessBufferChannelCount();
 
    const int kSafetyMaxStereoChannels = VSTPlugin::maxStereoOutputChannels; //hitting a crazy issue (memory stomp?) where numchannels is getting blown out sometimes
 
    int bufferSize = GetBuffer()->BufferSize();
    assert(bufferSize == gBufferSize);
 
-   juce::AudioBuffer<float> buffer(juceBufferChannelCount, bufferSize);
-   for (int i = 0; i < inputChannels && i < kSafetyMaxStereoChannels; ++i)
-      buffer.copyFrom(i, 0, AllChannelsBuffer->GetChannel(MIN(i, GetBuffer()->NumActiveChannels() - 1)), AllChannelsBuffer->BufferSize());
+   //a plain stereo in/out plugin can process our buffer in place, everything else goes through the preallocated buffer
+   bool processInPlace = juceBufferChannelCount == 2 && inputChannels == 2 && AllChannelsBuffer->NumActiveChannels() == 2 && mAdditionalOutCableSources.empty();
+   if (processInPlace)
+   {
+      float* channels[2] = { AllChannelsBuffer->GetChannel(0), AllChannelsBuffer->GetChannel(1) };
+      mInPlaceBuffer.setDataToReferTo(channels, 2, bufferSize);
+   }
+   else
+   {
+      if (mProcessBuffer.getNumChannels() != juceBufferChannelCount || mProcessBuffer.getNumSamples() != bufferSize)
+         mProcessBuffer.setSize(juceBufferChannelCount, bufferSize, false, false, true); //shouldn't happen once prepared
+
+      int numInputsCopied = 0;
+      for (int i = 0; i < inputChannels && i < kSafetyMaxStereoChannels; ++i)
+      {
+         mProcessBuffer.copyFrom(i, 0, AllChannelsBuffer->GetChannel(MIN(i, GetBuffer()->NumActiveChannels() - 1)), AllChannelsBuffer->BufferSize());
+         ++numInputsCopied;
+      }
+      for (int i = numInputsCopied; i < juceBufferChannelCount; ++i)
+         mProcessBuffer.clear(i, 0, bufferSize); //don't hand the plugin last buffer's output as input
+   }
+   juce::AudioBuffer<float>& buffer = processInPlace ? mInPlaceBuffer : mProcessBuffer;
 
    IAudioReceiver* target = GetTarget();
 
@@ -921,10 +981,16 @@ void VSTPlugin::Process(double time)
             ofLog() << mMidiBuffer.getFirstEventTime() << " " << mMidiBuffer.getLastEventTime();
          }*/
 
-         mMidiBuffer.addEvents(mFutureMidiBuffer, 0, mFutureMidiBuffer.getLastEventTime() + 1, 0);
-         mFutureMidiBuffer.clear();
-         mFutureMidiBuffer.addEvents(mMidiBuffer, gBufferSize, mMidiBuffer.getLastEventTime() - gBufferSize + 1, -gBufferSize);
-         mMidiBuffer.clear(gBufferSize, mMidiBuffer.getLastEventTime() + 1);
+         if (!mFutureMidiBuffer.isEmpty())
+         {
+            mMidiBuffer.addEvents(mFutureMidiBuffer, 0, mFutureMidiBuffer.getLastEventTime() + 1, 0);
+            mFutureMidiBuffer.clear();
+         }
+         if (mMidiBuffer.getLastEventTime() >= gBufferSize)
+         {
+            mFutureMidiBuffer.addEvents(mMidiBuffer, gBufferSize, mMidiBuffer.getLastEventTime() - gBufferSize + 1, -gBufferSize);
+            mMidiBuffer.clear(gBufferSize, mMidiBuffer.getLastEventTime() + 1);
+         }
 
          if (mWantsPanic)
          {
@@ -966,7 +1032,8 @@ void VSTPlugin::Process(double time)
       }
       mVSTMutex.unlock();
 
-      AllChannelsBuffer->Clear();
+      if (!processInPlace)
+         AllChannelsBuffer->Clear();
 
       int numChannels = 2 + ((int)mAdditionalOutCableSources.size() * 2);
 
@@ -1006,14 +1073,11 @@ void VSTPlugin::Process(double time)
          }
 
          // Copy the output from juce into our own buffer
-         int numMonoSamples = buffer.getNumSamples();
-         for (int sampleIndex = 0; sampleIndex < numMonoSamples; ++sampleIndex)
-         {
-            auto temp_buffer = AllChannelsBuffer->GetChannel(sourceChannel);
-            if (temp_buffer == nullptr)
-               continue;
-            temp_buffer[sampleIndex] += buffer.getSample(sourceChannel, sampleIndex) * mVol;
-         }
+         auto temp_buffer = AllChannelsBuffer->GetChannel(sourceChannel);
+         if (processInPlace)
+            juce::FloatVectorOperations::multiply(temp_buffer, mVol, buffer.getNumSamples());
+         else
+            juce::FloatVectorOperations::addWithMultiply(temp_buffer, buffer.getReadPointer(sourceChannel), mVol, buffer.getNumSamples());
 
          // Copy the outputs from the single buffer into our multiple output buffers
          if (CurrentTargetAudioReceiver)
@@ -84,6 +84,7 @@ public:
    //IAudioSource
    void Process(double time) override;
    void SetEnabled(bool enabled) override;
+   int GetLatencySamples() override { return mLatencySamples; }
 
    //INoteReceiver
    void PlayNote(NoteMessage note) override;
@@ -113,6 +114,8 @@ private:
    void DrawModule() override;
    void GetModuleDimensions(float& width, float& height) override;
    void LoadVST(juce::PluginDescription desc);
+   int GetProcessBufferChannelCount() const;
+   void PrepareProcessBuffers();
    void LoadVSTFromSaveData(FileStreamIn& in, int rev);
    void GetVSTFileDesc(std::string vstName, juce::PluginDescription& desc);
 
@@ -157,6 +160,8 @@ private:
    std::unique_ptr<VSTWindow> mWindow;
    juce::MidiBuffer mMidiBuffer;
    juce::MidiBuffer mFutureMidiBuffer;
+   juce::AudioBuffer<float> mProcessBuffer; //sized when the plugin is prepared, so Process() doesn't allocate
+   juce::AudioBuffer<float> mInPlaceBuffer; //refers directly to our ChannelBuffer for plain stereo plugins
    juce::CriticalSection mMidiInputLock;
    std::atomic<bool> mRescanParameterNames{ false };
    juce::String cutOffIdHash(juce::String);
@@ -190,6 +195,7 @@ private:
    std::string mOldVstPath{ "" }; //for loading save files that predate pluginId-style saving
    int mParameterVersion{ 1 };
    int mLastNumChannels{ -1 };
+   int mLatencySamples{ 0 }; //as last reported by the plugin, polled so that delay compensation can be recalculated when it changes
 
    // juce supports a max of 16 stereo output channels
    static const int maxStereoOutputChannels{ 16 };
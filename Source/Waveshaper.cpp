@@ -54,6 +54,10 @@ void Waveshaper::CreateUIControls()
    mCSlider = new FloatSlider(this, "c", mBSlider, kAnchor_Below, 110, 15, &mC, -10, 10, 4);
    mDSlider = new FloatSlider(this, "d", mCSlider, kAnchor_Below, 110, 15, &mD, -10, 10, 4);
    mESlider = new FloatSlider(this, "e", mDSlider, kAnchor_Below, 110, 15, &mE, -10, 10, 4);
+   mOversamplingDropdown = new DropdownList(this, "oversample", mESlider, kAnchor_Below, &mOversampling, 40);
+   mOversamplingDropdown->DrawLabel(true);
+
+   Oversampler::FillDropdown(mOversamplingDropdown);
 
    mSymbolTable.add_variable("x", mExpressionInput);
    mSymbolTable.add_variable("x1", mHistPre1);
@@ -90,6 +94,17 @@ Waveshaper::~Waveshaper()
 {
 }
 
+void Waveshaper::DropdownUpdated(DropdownList* list, int oldVal, double time)
+{
+   if (list == mOversamplingDropdown)
+   {
+      //setting up the oversamplers allocates, so do it here rather than on the audio thread, which waits for it
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "Waveshaper::DropdownUpdated()");
+      for (auto& oversampler : mOversamplers)
+         oversampler.Setup(mOversampling, gBufferSize);
+   }
+}
+
 void Waveshaper::Process(double time)
 {
    PROFILER(Waveshaper);
@@ -104,12 +119,9 @@ void Waveshaper::Process(double time)
    if (!mEnabled)
    {
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-      {
-         Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize());
          GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize(), ch);
-      }
 
-      GetBuffer()->Reset();
+      SendBufferToTarget(target);
       return;
    }
 
@@ -118,15 +130,21 @@ void Waveshaper::Process(double time)
 
    int bufferSize = GetBuffer()->BufferSize();
 
-   ChannelBuffer* out = target->GetBuffer();
+   const int oversampling = mOversamplers[0].GetFactor(); //what DropdownUpdated() set them up for
+   const int numSamples = bufferSize * oversampling;
+   const double sampleStepMs = gInvSampleRateMs / oversampling;
+
    for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
    {
       float* buffer = GetBuffer()->GetChannel(ch);
       if (mExpressionValid)
       {
-         for (int i = 0; i < bufferSize; ++i)
+         if (oversampling > 1)
+            buffer = mOversamplers[ch].Upsample(buffer, bufferSize);
+
+         for (int i = 0; i < numSamples; ++i)
          {
-            ComputeSliders(i);
+            ComputeSliders(i / oversampling);
             mExpressionInput = buffer[i] * mRescale;
 
             mHistPre1 = mBiquadState[ch].mHistPre1;
@@ -139,7 +157,7 @@ void Waveshaper::Process(double time)
             if (mExpressionInput < min)
                min = mExpressionInput;
 
-            mT = (gTime + i * gInvSampleRateMs) * .001;
+            mT = (gTime + i * sampleStepMs) * .001;
             buffer[i] = mExpression.value() / mRescale;
 
             mBiquadState[ch].mHistPre2 = mBiquadState[ch].mHistPre1;
@@ -147,15 +165,30 @@ void Waveshaper::Process(double time)
             mBiquadState[ch].mHistPost2 = mBiquadState[ch].mHistPost1;
             mBiquadState[ch].mHistPost1 = ofClamp(buffer[i], -1, 1); //keep feedback from spiraling out of control
          }
+
+         if (oversampling > 1)
+         {
+            mOversamplers[ch].Downsample(buffer, GetBuffer()->GetChannel(ch), bufferSize);
+            buffer = GetBuffer()->GetChannel(ch);
+         }
       }
-      Add(out->GetChannel(ch), buffer, bufferSize);
       GetVizBuffer()->WriteChunk(buffer, bufferSize, ch);
    }
 
    mSmoothMax = max > mSmoothMax ? max : ofLerp(mSmoothMax, max, .01f);
    mSmoothMin = min < mSmoothMin ? min : ofLerp(mSmoothMin, min, .01f);
 
-   GetBuffer()->Reset();
+   SendBufferToTarget(target);
+}
+
+void Waveshaper::Poll()
+{
+   int latencySamples = (mEnabled && mExpressionValid) ? Oversampler::GetLatencySamples(mOversampling) : 0;
+   if (latencySamples != mLatencySamples)
+   {
+      mLatencySamples = latencySamples;
+      TheSynth->ArrangeAudioSourceDependencies();
+   }
 }
 
 void Waveshaper::TextEntryComplete(TextEntry* entry)
@@ -215,12 +248,13 @@ void Waveshaper::DrawModule()
    mCSlider->Draw();
    mDSlider->Draw();
    mESlider->Draw();
+   mOversamplingDropdown->Draw();
 }
 
 void Waveshaper::GetModuleDimensions(float& w, float& h)
 {
    w = MAX(kGraphX + kGraphWidth + 2, 4 + mTextEntry->GetRect().width);
-   h = kGraphY + kGraphHeight;
+   h = MAX(kGraphY + kGraphHeight, mOversamplingDropdown->GetRect(true).getMaxY() + 2);
 }
 
 void Waveshaper::LoadLayout(const ofxJSONElement& moduleInfo)
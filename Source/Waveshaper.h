@@ -32,9 +32,11 @@
 #include "Slider.h"
 #include "ClickButton.h"
 #include "TextEntry.h"
+#include "DropdownList.h"
+#include "Oversampler.h"
 #include "exprtk.hpp"
 
-class Waveshaper : public IAudioProcessor, public IDrawableModule, public IFloatSliderListener, public ITextEntryListener
+class Waveshaper : public IAudioProcessor, public IDrawableModule, public IFloatSliderListener, public ITextEntryListener, public IDropdownListener
 {
 public:
    Waveshaper();
@@ -49,10 +51,16 @@ public:
    //IAudioSource
    void Process(double time) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
+   int GetLatencySamples() override { return mLatencySamples; }
+
+   void Poll() override;
 
    //IFloatSliderListener
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override {}
 
+   //IDropdownListener
+   void DropdownUpdated(DropdownList* list, int oldVal, double time) override;
+
    //ITextEntryListener
    void TextEntryComplete(TextEntry* entry) override;
 
@@ -78,6 +86,10 @@ private:
    FloatSlider* mDSlider{ nullptr };
    float mE{ 0 };
    FloatSlider* mESlider{ nullptr };
+   int mOversampling{ 1 };
+   DropdownList* mOversamplingDropdown{ nullptr };
+   Oversampler mOversamplers[ChannelBuffer::kMaxNumChannels]{};
+   int mLatencySamples{ 0 };
 
    std::string mEntryString{ "x" };
    TextEntry* mTextEntry{ nullptr };